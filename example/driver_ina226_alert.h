@@ -67,6 +67,16 @@ extern "C"{
  */
 uint8_t ina226_alert_irq_handler(void);
 
+/**
+ * @brief     alert irq handler with the edge timestamp
+ * @param[in] timestamp_us alert edge timestamp in us
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+uint8_t ina226_alert_irq_handler_timestamp(uint64_t timestamp_us);
+
 /**
  * @brief     alert example init
  * @param[in] addr_pin iic address pin
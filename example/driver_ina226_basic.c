@@ -50,7 +50,7 @@ static ina226_handle_t gs_handle;        /**< ina226 handle */
 uint8_t ina226_basic_init(ina226_address_t addr_pin, double r)
 {
     uint8_t res;
-    uint16_t calibration;
+    ina226_config_t config;
     
     /* link interface function */
     DRIVER_INA226_LINK_INIT(&gs_handle, ina226_handle_t);
@@ -58,8 +58,11 @@ uint8_t ina226_basic_init(ina226_address_t addr_pin, double r)
     DRIVER_INA226_LINK_IIC_DEINIT(&gs_handle, ina226_interface_iic_deinit);
     DRIVER_INA226_LINK_IIC_READ(&gs_handle, ina226_interface_iic_read);
     DRIVER_INA226_LINK_IIC_WRITE(&gs_handle, ina226_interface_iic_write);
+    DRIVER_INA226_LINK_IIC_READ_CMD(&gs_handle, ina226_interface_iic_read_cmd);
+    DRIVER_INA226_LINK_IIC_READ_BATCH(&gs_handle, ina226_interface_iic_read_batch);
     DRIVER_INA226_LINK_DELAY_MS(&gs_handle, ina226_interface_delay_ms);
     DRIVER_INA226_LINK_DEBUG_PRINT(&gs_handle, ina226_interface_debug_print);
+    DRIVER_INA226_LINK_GET_TIME_US(&gs_handle, ina226_interface_get_time_us);
     DRIVER_INA226_LINK_RECEIVE_CALLBACK(&gs_handle, ina226_interface_receive_callback);
     
     /* set addr pin */
@@ -89,38 +92,8 @@ uint8_t ina226_basic_init(ina226_address_t addr_pin, double r)
         return 1;
     }
     
-    /* set default average mode */
-    res = ina226_set_average_mode(&gs_handle, INA226_BASIC_DEFAULT_AVG_MODE);
-    if (res != 0)
-    {
-        ina226_interface_debug_print("ina226: set average mode failed.\n");
-        (void)ina226_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default bus voltage conversion time */
-    res = ina226_set_bus_voltage_conversion_time(&gs_handle, INA226_BASIC_DEFAULT_BUS_VOLTAGE_CONVERSION_TIME);
-    if (res != 0)
-    {
-        ina226_interface_debug_print("ina226: set bus voltage conversion time failed.\n");
-        (void)ina226_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default shunt voltage conversion time */
-    res = ina226_set_shunt_voltage_conversion_time(&gs_handle, INA226_BASIC_DEFAULT_SHUNT_VOLTAGE_CONVERSION_TIME);
-    if (res != 0)
-    {
-        ina226_interface_debug_print("ina226: set shunt voltage conversion time failed.\n");
-        (void)ina226_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
     /* calculate calibration */
-    res = ina226_calculate_calibration(&gs_handle, (uint16_t *)&calibration);
+    res = ina226_calculate_calibration(&gs_handle, (uint16_t *)&config.calibration);
     if (res != 0)
     {
         ina226_interface_debug_print("ina226: calculate calibration failed.\n");
@@ -128,20 +101,16 @@ uint8_t ina226_basic_init(ina226_address_t addr_pin, double r)
         
         return 1;
     }
-    res = ina226_set_calibration(&gs_handle, calibration);
-    if (res != 0)
-    {
-        ina226_interface_debug_print("ina226: set calibration failed.\n");
-        (void)ina226_deinit(&gs_handle);
-        
-        return 1;
-    }
     
-    /* set shunt bus voltage continuous */
-    res = ina226_set_mode(&gs_handle, INA226_MODE_SHUNT_BUS_VOLTAGE_CONTINUOUS);
+    /* set default config and shunt bus voltage continuous */
+    config.avg = INA226_BASIC_DEFAULT_AVG_MODE;
+    config.bus_voltage_conversion_time = INA226_BASIC_DEFAULT_BUS_VOLTAGE_CONVERSION_TIME;
+    config.shunt_voltage_conversion_time = INA226_BASIC_DEFAULT_SHUNT_VOLTAGE_CONVERSION_TIME;
+    config.mode = INA226_MODE_SHUNT_BUS_VOLTAGE_CONTINUOUS;
+    res = ina226_set_config(&gs_handle, &config, INA226_BOOL_TRUE);
     if (res != 0)
     {
-        ina226_interface_debug_print("ina226: set mode failed.\n");
+        ina226_interface_debug_print("ina226: set config failed.\n");
         (void)ina226_deinit(&gs_handle);
         
         return 1;
@@ -163,29 +132,24 @@ uint8_t ina226_basic_init(ina226_address_t addr_pin, double r)
 uint8_t ina226_basic_read(float *mV, float *mA, float *mW)
 {
     uint8_t res;
-    int16_t s_raw;
-    uint16_t u_raw;
-    
-    /* read bus voltage */
-    res = ina226_read_bus_voltage(&gs_handle, (uint16_t *)&u_raw, mV);
-    if (res != 0)
-    {
-        return 1;
-    }
+    ina226_sample_t sample;
     
-    /* read current */
-    res = ina226_read_current(&gs_handle, (int16_t *)&s_raw, mA);
+    /* read all */
+    res = ina226_read_all(&gs_handle, &sample);
     if (res != 0)
     {
         return 1;
     }
     
-    /* read power */
-    res = ina226_read_power(&gs_handle, (uint16_t *)&u_raw, mW);
+    /* convert the sample */
+    res = ina226_sample_convert_to_data(&gs_handle, &sample);
     if (res != 0)
     {
         return 1;
     }
+    *mV = sample.bus_voltage_mV;
+    *mA = sample.current_mA;
+    *mW = sample.power_mW;
     
     return 0;
 }
@@ -38,6 +38,19 @@
 
 static ina226_handle_t gs_handle;        /**< ina226 handle */
 
+/**
+ * @brief  shot irq handler
+ * @return status code
+ *         - 0 success
+ * @note   wakes a read waiting on the conversion ready alert
+ */
+uint8_t ina226_shot_irq_handler(void)
+{
+    ina226_interface_ready_notify();
+    
+    return 0;
+}
+
 /**
  * @brief     shot example init
  * @param[in] addr_pin iic address pin
@@ -50,7 +63,7 @@ static ina226_handle_t gs_handle;        /**< ina226 handle */
 uint8_t ina226_shot_init(ina226_address_t addr_pin, double r)
 {
     uint8_t res;
-    uint16_t calibration;
+    ina226_config_t config;
     
     /* link interface function */
     DRIVER_INA226_LINK_INIT(&gs_handle, ina226_handle_t);
@@ -58,9 +71,14 @@ uint8_t ina226_shot_init(ina226_address_t addr_pin, double r)
     DRIVER_INA226_LINK_IIC_DEINIT(&gs_handle, ina226_interface_iic_deinit);
     DRIVER_INA226_LINK_IIC_READ(&gs_handle, ina226_interface_iic_read);
     DRIVER_INA226_LINK_IIC_WRITE(&gs_handle, ina226_interface_iic_write);
+    DRIVER_INA226_LINK_IIC_READ_CMD(&gs_handle, ina226_interface_iic_read_cmd);
+    DRIVER_INA226_LINK_IIC_READ_BATCH(&gs_handle, ina226_interface_iic_read_batch);
     DRIVER_INA226_LINK_DELAY_MS(&gs_handle, ina226_interface_delay_ms);
+    DRIVER_INA226_LINK_DELAY_US(&gs_handle, ina226_interface_delay_us);
     DRIVER_INA226_LINK_DEBUG_PRINT(&gs_handle, ina226_interface_debug_print);
+    DRIVER_INA226_LINK_GET_TIME_US(&gs_handle, ina226_interface_get_time_us);
     DRIVER_INA226_LINK_RECEIVE_CALLBACK(&gs_handle, ina226_interface_receive_callback);
+    DRIVER_INA226_LINK_WAIT_READY(&gs_handle, ina226_interface_wait_ready);
     
     /* set addr pin */
     res = ina226_set_addr_pin(&gs_handle, addr_pin);
@@ -89,110 +107,159 @@ uint8_t ina226_shot_init(ina226_address_t addr_pin, double r)
         return 1;
     }
     
-    /* set default average mode */
-    res = ina226_set_average_mode(&gs_handle, INA226_SHOT_DEFAULT_AVG_MODE);
+    /* calculate calibration */
+    res = ina226_calculate_calibration(&gs_handle, (uint16_t *)&config.calibration);
     if (res != 0)
     {
-        ina226_interface_debug_print("ina226: set average mode failed.\n");
+        ina226_interface_debug_print("ina226: calculate calibration failed.\n");
         (void)ina226_deinit(&gs_handle);
         
         return 1;
     }
     
-    /* set default bus voltage conversion time */
-    res = ina226_set_bus_voltage_conversion_time(&gs_handle, INA226_SHOT_DEFAULT_BUS_VOLTAGE_CONVERSION_TIME);
+    /* set default config and power down */
+    config.avg = INA226_SHOT_DEFAULT_AVG_MODE;
+    config.bus_voltage_conversion_time = INA226_SHOT_DEFAULT_BUS_VOLTAGE_CONVERSION_TIME;
+    config.shunt_voltage_conversion_time = INA226_SHOT_DEFAULT_SHUNT_VOLTAGE_CONVERSION_TIME;
+    config.mode = INA226_MODE_POWER_DOWN;
+    res = ina226_set_config(&gs_handle, &config, INA226_BOOL_TRUE);
     if (res != 0)
     {
-        ina226_interface_debug_print("ina226: set bus voltage conversion time failed.\n");
+        ina226_interface_debug_print("ina226: set config failed.\n");
         (void)ina226_deinit(&gs_handle);
         
         return 1;
     }
     
-    /* set default shunt voltage conversion time */
-    res = ina226_set_shunt_voltage_conversion_time(&gs_handle, INA226_SHOT_DEFAULT_SHUNT_VOLTAGE_CONVERSION_TIME);
+    /* set default conversion ready alert pin */
+    res = ina226_set_conversion_ready_alert_pin(&gs_handle, INA226_SHOT_DEFAULT_READY_ALERT_PIN);
     if (res != 0)
     {
-        ina226_interface_debug_print("ina226: set shunt voltage conversion time failed.\n");
+        ina226_interface_debug_print("ina226: set conversion ready alert pin failed.\n");
         (void)ina226_deinit(&gs_handle);
         
         return 1;
     }
     
-    /* calculate calibration */
-    res = ina226_calculate_calibration(&gs_handle, (uint16_t *)&calibration);
+    return 0;
+}
+
+/**
+ * @brief      shot example read
+ * @param[out] *mV pointer to a mV buffer
+ * @param[out] *mA pointer to a mA buffer
+ * @param[out] *mW pointer to a mW buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t ina226_shot_read(float *mV, float *mA, float *mW)
+{
+    uint8_t res;
+    ina226_sample_t sample;
+    
+    /* set shunt bus voltage triggered */
+    res = ina226_set_mode(&gs_handle, INA226_MODE_SHUNT_BUS_VOLTAGE_TRIGGERED);
     if (res != 0)
     {
-        ina226_interface_debug_print("ina226: calculate calibration failed.\n");
-        (void)ina226_deinit(&gs_handle);
-        
         return 1;
     }
-    res = ina226_set_calibration(&gs_handle, calibration);
+    
+    /* read all */
+    res = ina226_read_all(&gs_handle, &sample);
     if (res != 0)
     {
-        ina226_interface_debug_print("ina226: set calibration failed.\n");
-        (void)ina226_deinit(&gs_handle);
-        
         return 1;
     }
     
-    /* set power down */
-    res = ina226_set_mode(&gs_handle, INA226_MODE_POWER_DOWN);
+    /* convert the sample */
+    res = ina226_sample_convert_to_data(&gs_handle, &sample);
     if (res != 0)
     {
-        ina226_interface_debug_print("ina226: set mode failed.\n");
-        (void)ina226_deinit(&gs_handle);
-        
         return 1;
     }
+    *mV = sample.bus_voltage_mV;
+    *mA = sample.current_mA;
+    *mW = sample.power_mW;
     
     return 0;
 }
 
 /**
- * @brief      shot example read
- * @param[out] *mV pointer to a mV buffer
- * @param[out] *mA pointer to a mA buffer
- * @param[out] *mW pointer to a mW buffer
- * @return     status code
- *             - 0 success
- *             - 1 read failed
- * @note       none
+ * @brief  shot example start a conversion
+ * @return status code
+ *         - 0 success
+ *         - 1 start failed
+ * @note   none
  */
-uint8_t ina226_shot_read(float *mV, float *mA, float *mW)
+uint8_t ina226_shot_start(void)
 {
     uint8_t res;
-    int16_t s_raw;
-    uint16_t u_raw;
     
-    /* set shunt bus voltage triggered */
-    res = ina226_set_mode(&gs_handle, INA226_MODE_SHUNT_BUS_VOLTAGE_TRIGGERED);
+    /* start conversion */
+    res = ina226_start_conversion(&gs_handle);
     if (res != 0)
     {
         return 1;
     }
     
-    /* read bus voltage */
-    res = ina226_read_bus_voltage(&gs_handle, (uint16_t *)&u_raw, mV);
+    return 0;
+}
+
+/**
+ * @brief      shot example poll the conversion
+ * @param[out] *ready pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 poll failed
+ * @note       none
+ */
+uint8_t ina226_shot_poll(ina226_bool_t *ready)
+{
+    uint8_t res;
+    
+    /* poll conversion */
+    res = ina226_poll_conversion(&gs_handle, ready);
     if (res != 0)
     {
         return 1;
     }
     
-    /* read current */
-    res = ina226_read_current(&gs_handle, (int16_t *)&s_raw, mA);
+    return 0;
+}
+
+/**
+ * @brief      shot example fetch the sample
+ * @param[out] *mV pointer to a mV buffer
+ * @param[out] *mA pointer to a mA buffer
+ * @param[out] *mW pointer to a mW buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 fetch failed
+ * @note       none
+ */
+uint8_t ina226_shot_fetch(float *mV, float *mA, float *mW)
+{
+    uint8_t res;
+    ina226_sample_t sample;
+    
+    /* fetch sample */
+    res = ina226_fetch_sample(&gs_handle, &sample);
     if (res != 0)
     {
         return 1;
     }
     
-    /* read power */
-    res = ina226_read_power(&gs_handle, (uint16_t *)&u_raw, mW);
+    /* convert the sample */
+    res = ina226_sample_convert_to_data(&gs_handle, &sample);
     if (res != 0)
     {
         return 1;
     }
+    *mV = sample.bus_voltage_mV;
+    *mA = sample.current_mA;
+    *mW = sample.power_mW;
     
     return 0;
 }
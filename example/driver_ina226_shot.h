@@ -54,6 +54,15 @@ extern "C"{
 #define INA226_SHOT_DEFAULT_AVG_MODE                             INA226_AVG_16                        /**< 16 averages */
 #define INA226_SHOT_DEFAULT_BUS_VOLTAGE_CONVERSION_TIME          INA226_CONVERSION_TIME_1P1_MS        /**< bus voltage conversion time 1.1 ms */
 #define INA226_SHOT_DEFAULT_SHUNT_VOLTAGE_CONVERSION_TIME        INA226_CONVERSION_TIME_1P1_MS        /**< shunt voltage conversion time 1.1 ms */
+#define INA226_SHOT_DEFAULT_READY_ALERT_PIN                      INA226_BOOL_FALSE                    /**< disable ready alert pin */
+
+/**
+ * @brief  shot irq handler
+ * @return status code
+ *         - 0 success
+ * @note   wakes a read waiting on the conversion ready alert
+ */
+uint8_t ina226_shot_irq_handler(void);
 
 /**
  * @brief     shot example init
@@ -87,6 +96,37 @@ uint8_t ina226_shot_deinit(void);
  */
 uint8_t ina226_shot_read(float *mV, float *mA, float *mW);
 
+/**
+ * @brief  shot example start a conversion
+ * @return status code
+ *         - 0 success
+ *         - 1 start failed
+ * @note   none
+ */
+uint8_t ina226_shot_start(void);
+
+/**
+ * @brief      shot example poll the conversion
+ * @param[out] *ready pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 poll failed
+ * @note       none
+ */
+uint8_t ina226_shot_poll(ina226_bool_t *ready);
+
+/**
+ * @brief      shot example fetch the sample
+ * @param[out] *mV pointer to a mV buffer
+ * @param[out] *mA pointer to a mA buffer
+ * @param[out] *mW pointer to a mW buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 fetch failed
+ * @note       none
+ */
+uint8_t ina226_shot_fetch(float *mV, float *mA, float *mW);
+
 /**
  * @}
  */
@@ -94,6 +94,31 @@ uint8_t ina226_interface_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint1
  */
 uint8_t ina226_interface_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
 
+/**
+ * @brief      interface iic bus read without the register address
+ * @param[in]  addr iic device write address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t ina226_interface_iic_read_cmd(uint8_t addr, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief      interface iic bus read of several registers in one transaction
+ * @param[in]  *addr pointer to an iic device write address array
+ * @param[in]  *reg pointer to an iic register address array
+ * @param[out] *buf pointer to a data buffer of num * 2 bytes
+ * @param[in]  num read number
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       each read is 2 bytes
+ */
+uint8_t ina226_interface_iic_read_batch(uint8_t *addr, uint8_t *reg, uint8_t *buf, uint8_t num);
+
 /**
  * @brief     interface delay ms
  * @param[in] ms time
@@ -101,6 +126,13 @@ uint8_t ina226_interface_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint
  */
 void ina226_interface_delay_ms(uint32_t ms);
 
+/**
+ * @brief     interface delay us
+ * @param[in] us time
+ * @note      none
+ */
+void ina226_interface_delay_us(uint32_t us);
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
@@ -115,6 +147,29 @@ void ina226_interface_debug_print(const char *const fmt, ...);
  */
 void ina226_interface_receive_callback(uint8_t type);
 
+/**
+ * @brief     interface wait the conversion ready alert
+ * @param[in] ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 wait timeout
+ * @note      block until ina226_interface_ready_notify is called or ms passes
+ */
+uint8_t ina226_interface_wait_ready(uint32_t ms);
+
+/**
+ * @brief interface conversion ready notify
+ * @note  call it from the alert pin interrupt
+ */
+void ina226_interface_ready_notify(void);
+
+/**
+ * @brief  interface get time us
+ * @return monotonic time in us
+ * @note   none
+ */
+uint64_t ina226_interface_get_time_us(void);
+
 /**
  * @}
  */
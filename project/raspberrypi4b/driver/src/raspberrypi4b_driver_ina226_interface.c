@@ -37,6 +37,8 @@
 #include "driver_ina226_interface.h"
 #include "iic.h"
 #include <stdarg.h>
+#include <pthread.h>
+#include <time.h>
 
 /**
  * @brief iic device name definition
@@ -47,17 +49,49 @@
  * @brief iic device handle definition
  */
 static int gs_fd;                           /**< iic handle */
+static uint8_t gs_ref = 0;                  /**< iic reference count */
+
+/**
+ * @brief conversion ready event definition
+ */
+static pthread_mutex_t gs_ready_mutex = PTHREAD_MUTEX_INITIALIZER;        /**< ready mutex */
+static pthread_cond_t gs_ready_cond;                                      /**< ready condition */
+static pthread_once_t gs_ready_once = PTHREAD_ONCE_INIT;                  /**< ready condition init once */
+static uint8_t gs_ready = 0;                                              /**< ready flag */
+
+/**
+ * @brief  init the ready condition on the monotonic clock
+ * @note   none
+ */
+static void a_ready_cond_init(void)
+{
+    pthread_condattr_t attr;
+    
+    (void)pthread_condattr_init(&attr);
+    (void)pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    (void)pthread_cond_init(&gs_ready_cond, &attr);
+    (void)pthread_condattr_destroy(&attr);
+}
 
 /**
  * @brief  interface iic bus init
  * @return status code
  *         - 0 success
  *         - 1 iic init failed
- * @note   none
+ * @note   the bus is shared by all handles and opened once
  */
 uint8_t ina226_interface_iic_init(void)
 {
-    return iic_init(IIC_DEVICE_NAME, &gs_fd);
+    if (gs_ref == 0)
+    {
+        if (iic_init(IIC_DEVICE_NAME, &gs_fd) != 0)
+        {
+            return 1;
+        }
+    }
+    gs_ref++;
+    
+    return 0;
 }
 
 /**
@@ -65,11 +99,21 @@ uint8_t ina226_interface_iic_init(void)
  * @return status code
  *         - 0 success
  *         - 1 iic deinit failed
- * @note   none
+ * @note   the bus is closed by the last handle
  */
 uint8_t ina226_interface_iic_deinit(void)
 {
-    return iic_deinit(gs_fd);
+    if (gs_ref == 0)
+    {
+        return 1;
+    }
+    gs_ref--;
+    if (gs_ref == 0)
+    {
+        return iic_deinit(gs_fd);
+    }
+    
+    return 0;
 }
 
 /**
@@ -104,6 +148,37 @@ uint8_t ina226_interface_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint
     return iic_write(gs_fd, addr, reg, buf, len);
 }
 
+/**
+ * @brief      interface iic bus read without the register address
+ * @param[in]  addr iic device write address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t ina226_interface_iic_read_cmd(uint8_t addr, uint8_t *buf, uint16_t len)
+{
+    return iic_read_cmd(gs_fd, addr, buf, len);
+}
+
+/**
+ * @brief      interface iic bus read of several registers in one transaction
+ * @param[in]  *addr pointer to an iic device write address array
+ * @param[in]  *reg pointer to an iic register address array
+ * @param[out] *buf pointer to a data buffer of num * 2 bytes
+ * @param[in]  num read number
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       each read is 2 bytes
+ */
+uint8_t ina226_interface_iic_read_batch(uint8_t *addr, uint8_t *reg, uint8_t *buf, uint8_t num)
+{
+    return iic_read_batch(gs_fd, addr, reg, buf, 2, num);
+}
+
 /**
  * @brief     interface delay ms
  * @param[in] ms time
@@ -114,6 +189,16 @@ void ina226_interface_delay_ms(uint32_t ms)
     usleep(ms * 1000);
 }
 
+/**
+ * @brief     interface delay us
+ * @param[in] us time
+ * @note      none
+ */
+void ina226_interface_delay_us(uint32_t us)
+{
+    usleep(us);
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
@@ -181,3 +266,70 @@ void ina226_interface_receive_callback(uint8_t type)
         }
     }
 }
+
+/**
+ * @brief     interface wait the conversion ready alert
+ * @param[in] ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 wait timeout
+ * @note      none
+ */
+uint8_t ina226_interface_wait_ready(uint32_t ms)
+{
+    int res;
+    struct timespec t;
+    
+    (void)pthread_once(&gs_ready_once, a_ready_cond_init);
+    (void)clock_gettime(CLOCK_MONOTONIC, &t);
+    t.tv_sec += ms / 1000;
+    t.tv_nsec += (long)(ms % 1000) * 1000000L;
+    if (t.tv_nsec >= 1000000000L)
+    {
+        t.tv_sec++;
+        t.tv_nsec -= 1000000000L;
+    }
+    res = 0;
+    (void)pthread_mutex_lock(&gs_ready_mutex);
+    while ((gs_ready == 0) && (res == 0))
+    {
+        res = pthread_cond_timedwait(&gs_ready_cond, &gs_ready_mutex, &t);
+    }
+    if (gs_ready == 0)
+    {
+        (void)pthread_mutex_unlock(&gs_ready_mutex);
+        
+        return 1;
+    }
+    gs_ready = 0;
+    (void)pthread_mutex_unlock(&gs_ready_mutex);
+    
+    return 0;
+}
+
+/**
+ * @brief interface conversion ready notify
+ * @note  call it from the alert pin interrupt
+ */
+void ina226_interface_ready_notify(void)
+{
+    (void)pthread_once(&gs_ready_once, a_ready_cond_init);
+    (void)pthread_mutex_lock(&gs_ready_mutex);
+    gs_ready = 1;
+    (void)pthread_cond_signal(&gs_ready_cond);
+    (void)pthread_mutex_unlock(&gs_ready_mutex);
+}
+
+/**
+ * @brief  interface get time us
+ * @return monotonic time in us
+ * @note   none
+ */
+uint64_t ina226_interface_get_time_us(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)(ts.tv_nsec / 1000);
+}
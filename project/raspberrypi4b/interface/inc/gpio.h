@@ -51,6 +51,20 @@
  * @{
  */
 
+/**
+ * @brief     gpio interrupt real time settings
+ * @param[in] priority SCHED_FIFO priority, 0 means the default scheduler
+ * @param[in] cpu cpu the pthread runs on, -1 means any cpu
+ * @param[in] lock 1 locks all memory with mlockall, 0 does not
+ * @return    status code
+ *            - 0 success
+ *            - 1 priority is invalid
+ * @note      call it before gpio_interrupt_init,
+ *            SCHED_FIFO and mlockall need CAP_SYS_NICE and CAP_IPC_LOCK,
+ *            a refused setting is reported and the pthread runs without it
+ */
+uint8_t gpio_interrupt_set_rt(int priority, int cpu, uint8_t lock);
+
 /**
  * @brief  gpio interrupt init
  * @return status code
@@ -65,10 +79,40 @@ uint8_t gpio_interrupt_init(void);
  * @return status code
  *         - 0 success
  *         - 1 deinit failed
- * @note   none
+ * @note   the pthread finishes the running callback, then exits
  */
 uint8_t gpio_interrupt_deinit(void);
 
+/**
+ * @brief      gpio event init
+ * @param[out] *fd pointer to an event fd buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 init failed
+ * @note       no pthread is created, poll the fd and call gpio_event_read
+ */
+uint8_t gpio_event_init(int *fd);
+
+/**
+ * @brief      gpio event read
+ * @param[out] *timestamp_ns pointer to a kernel timestamp buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 4 not a falling edge
+ * @note       the timestamp is the kernel event time in ns
+ */
+uint8_t gpio_event_read(uint64_t *timestamp_ns);
+
+/**
+ * @brief  gpio event deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t gpio_event_deinit(void);
+
 /**
  * @}
  */
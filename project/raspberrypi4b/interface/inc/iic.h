@@ -53,6 +53,11 @@ extern "C" {
  * @{
  */
 
+/**
+ * @brief iic batch max definition
+ */
+#define IIC_BATCH_MAX    21        /**< 42 messages, the I2C_RDWR limit */
+
 /**
  * @brief      iic bus init
  * @param[in]  *name pointer to an iic device name buffer
@@ -115,6 +120,21 @@ uint8_t iic_read(int fd, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
  */
 uint8_t iic_read_address16(int fd, uint8_t addr, uint16_t reg, uint8_t *buf, uint16_t len);
 
+/**
+ * @brief      iic bus read of several registers in one transaction
+ * @param[in]  fd iic handle
+ * @param[in]  *addr pointer to an iic device write address array
+ * @param[in]  *reg pointer to an iic register address array
+ * @param[out] *buf pointer to a data buffer of num * len bytes
+ * @param[in]  len length of each read
+ * @param[in]  num read number
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       addr = device_address_7bits << 1, num <= IIC_BATCH_MAX
+ */
+uint8_t iic_read_batch(int fd, uint8_t *addr, uint8_t *reg, uint8_t *buf, uint16_t len, uint8_t num);
+
 /**
  * @brief     iic bus write command
  * @param[in] fd iic handle
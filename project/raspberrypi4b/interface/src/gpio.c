@@ -34,9 +34,19 @@
  * </table>
  */
 
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
 #include "gpio.h"
 #include <gpiod.h>
 #include <pthread.h>
+#include <sched.h>
+#include <poll.h>
+#include <errno.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
 
 /**
  * @brief gpio device name definition
@@ -48,13 +58,24 @@
  */
 #define GPIO_DEVICE_LINE 17                      /**< gpio device line */
 
+/**
+ * @brief gpio event max definition
+ */
+#define GPIO_EVENT_MAX 16                        /**< events drained per wakeup */
+
 /**
  * @brief global var definition
  */
-static struct gpiod_chip *gs_chip;              /**< gpio chip handle */
-static struct gpiod_line *gs_line;              /**< gpio line handle */
-static pthread_t gs_pid;                        /**< gpio pthread pid */
-extern volatile uint8_t (*g_gpio_irq)(void);    /**< gpio extern callback */
+static struct gpiod_chip *gs_chip;                                       /**< gpio chip handle */
+static struct gpiod_line *gs_line;                                       /**< gpio line handle */
+static pthread_t gs_pid;                                                 /**< gpio pthread pid */
+static int gs_stop_fd = -1;                                              /**< gpio pthread stop event */
+static int gs_priority = 0;                                              /**< gpio pthread SCHED_FIFO priority */
+static int gs_cpu = -1;                                                  /**< gpio pthread cpu */
+static uint8_t gs_lock = 0;                                              /**< mlockall flag */
+static uint8_t gs_locked = 0;                                            /**< memory locked flag */
+extern volatile uint8_t (*g_gpio_irq)(void);                             /**< gpio extern callback */
+extern uint8_t (*g_gpio_irq_timestamp)(uint64_t timestamp_us);           /**< gpio extern timestamp callback */
 
 /**
  * @brief  gpio interrupt pthread
@@ -64,40 +85,115 @@ extern volatile uint8_t (*g_gpio_irq)(void);    /**< gpio extern callback */
  */
 static void *a_gpio_interrupt_pthread(void *p)
 {
+    int i;
     int res;
-    struct gpiod_line_event event;
+    struct pollfd fds[2];
+    struct gpiod_line_event event[GPIO_EVENT_MAX];
+    
+    (void)p;
+    
+    /* wait on the line and the stop event */
+    fds[0].fd = gpiod_line_event_get_fd(gs_line);
+    fds[0].events = POLLIN;
+    fds[1].fd = gs_stop_fd;
+    fds[1].events = POLLIN;
     
-    /* enable catching cancel signal */
-    pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, NULL);
-
-    /* cancel the pthread at once */
-    pthread_setcanceltype(PTHREAD_CANCEL_ASYNCHRONOUS, NULL);
-
     /* loop */
     while (1)
     {
         /* wait for the event */
-        res = gpiod_line_event_wait(gs_line, NULL);
-        if (res == 1)
+        res = poll(fds, 2, -1);
+        if (res < 0)
         {
-            /* read the event */
-            if (gpiod_line_event_read(gs_line, &event) != 0)
+            if (errno == EINTR)
             {
                 continue;
             }
-
-            /* if the falling edge */
-            if (event.event_type == GPIOD_LINE_EVENT_FALLING_EDGE)
+            perror("gpio: poll failed.\n");
+            
+            break;
+        }
+        
+        /* stop at once */
+        if (fds[1].revents != 0)
+        {
+            break;
+        }
+        if ((fds[0].revents & (POLLERR | POLLHUP | POLLNVAL)) != 0)
+        {
+            perror("gpio: line failed.\n");
+            
+            break;
+        }
+        if ((fds[0].revents & POLLIN) == 0)
+        {
+            continue;
+        }
+        
+        /* drain all queued events */
+        res = gpiod_line_event_read_multiple(gs_line, event, GPIO_EVENT_MAX);
+        if (res < 0)
+        {
+            perror("gpio: read events failed.\n");
+            
+            break;
+        }
+        for (i = 0; i < res; i++)
+        {
+            /* if not the falling edge */
+            if (event[i].event_type != GPIOD_LINE_EVENT_FALLING_EDGE)
+            {
+                continue;
+            }
+            
+            /* prefer the kernel timestamp of the edge */
+            if (g_gpio_irq_timestamp != NULL)
+            {
+                /* run the callback */
+                g_gpio_irq_timestamp((uint64_t)event[i].ts.tv_sec * 1000000ULL + (uint64_t)(event[i].ts.tv_nsec / 1000));
+            }
+            else if (g_gpio_irq != NULL)
+            {
+                /* run the callback */
+                g_gpio_irq();
+            }
+            else
             {
-                /* check the callback and try to run */
-                if (g_gpio_irq != NULL)
-                {
-                    /* run the callback */
-                    g_gpio_irq();
-                }
+                /* do nothing */
             }
         }
     }
+    
+    return NULL;
+}
+
+/**
+ * @brief     gpio interrupt real time settings
+ * @param[in] priority SCHED_FIFO priority, 0 means the default scheduler
+ * @param[in] cpu cpu the pthread runs on, -1 means any cpu
+ * @param[in] lock 1 locks all memory with mlockall, 0 does not
+ * @return    status code
+ *            - 0 success
+ *            - 1 priority is invalid
+ * @note      call it before gpio_interrupt_init,
+ *            SCHED_FIFO and mlockall need CAP_SYS_NICE and CAP_IPC_LOCK,
+ *            a refused setting is reported and the pthread runs without it
+ */
+uint8_t gpio_interrupt_set_rt(int priority, int cpu, uint8_t lock)
+{
+    /* check the priority */
+    if ((priority != 0) && 
+        ((priority < sched_get_priority_min(SCHED_FIFO)) || (priority > sched_get_priority_max(SCHED_FIFO))))
+    {
+        return 1;
+    }
+    
+    /* save the settings */
+    gs_priority = priority;
+    gs_cpu = cpu;
+    gs_lock = lock;
+    
+    return 0;
 }
 
 /**
@@ -109,7 +205,9 @@ static void *a_gpio_interrupt_pthread(void *p)
  */
 uint8_t gpio_interrupt_init(void)
 {
-    uint8_t res;
+    int res;
+    pthread_attr_t attr;
+    struct sched_param param;
     
     /* open the gpio group */
     gs_chip = gpiod_chip_open(GPIO_DEVICE_NAME);
@@ -138,16 +236,75 @@ uint8_t gpio_interrupt_init(void)
 
         return 1;
     }
+    
+    /* creat the stop event */
+    gs_stop_fd = eventfd(0, EFD_CLOEXEC);
+    if (gs_stop_fd < 0)
+    {
+        perror("gpio: creat eventfd failed.\n");
+        gpiod_chip_close(gs_chip);
+
+        return 1;
+    }
+    
+    /* lock the memory */
+    gs_locked = 0;
+    if (gs_lock != 0)
+    {
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+        {
+            perror("gpio: mlockall failed.\n");
+        }
+        else
+        {
+            gs_locked = 1;
+        }
+    }
+    
+    /* set the real time scheduler */
+    (void)pthread_attr_init(&attr);
+    if (gs_priority != 0)
+    {
+        param.sched_priority = gs_priority;
+        (void)pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+        (void)pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+        (void)pthread_attr_setschedparam(&attr, &param);
+    }
 
     /* creat a gpio interrupt pthread */
-    res = pthread_create(&gs_pid, NULL, a_gpio_interrupt_pthread, NULL);
+    res = pthread_create(&gs_pid, &attr, a_gpio_interrupt_pthread, NULL);
+    if ((res == EPERM) && (gs_priority != 0))
+    {
+        fprintf(stderr, "gpio: set SCHED_FIFO failed, %s.\n", strerror(res));
+        res = pthread_create(&gs_pid, NULL, a_gpio_interrupt_pthread, NULL);
+    }
+    (void)pthread_attr_destroy(&attr);
     if (res != 0)
     {
-        perror("gpio: creat pthread failed.\n");
+        fprintf(stderr, "gpio: creat pthread failed, %s.\n", strerror(res));
+        if (gs_locked != 0)
+        {
+            (void)munlockall();
+        }
+        (void)close(gs_stop_fd);
         gpiod_chip_close(gs_chip);
 
         return 1;
     }
+    
+    /* bind the cpu */
+    if (gs_cpu >= 0)
+    {
+        cpu_set_t set;
+        
+        CPU_ZERO(&set);
+        CPU_SET(gs_cpu, &set);
+        res = pthread_setaffinity_np(gs_pid, sizeof(cpu_set_t), &set);
+        if (res != 0)
+        {
+            fprintf(stderr, "gpio: set affinity failed, %s.\n", strerror(res));
+        }
+    }
 
     return 0;
 }
@@ -157,21 +314,134 @@ uint8_t gpio_interrupt_init(void)
  * @return status code
  *         - 0 success
  *         - 1 deinit failed
- * @note   none
+ * @note   the pthread finishes the running callback, then exits
  */
 uint8_t gpio_interrupt_deinit(void)
 {
-    uint8_t res;
+    uint64_t one = 1;
     
-    /* close the gpio interrupt pthread */
-    res = pthread_cancel(gs_pid);
-    if (res != 0)
+    /* wake the gpio interrupt pthread */
+    if (write(gs_stop_fd, &one, sizeof(one)) != sizeof(one))
+    {
+        perror("gpio: stop pthread failed.\n");
+
+        return 1;
+    }
+    
+    /* wait the gpio interrupt pthread */
+    if (pthread_join(gs_pid, NULL) != 0)
     {
-        perror("gpio: delete pthread failed.\n");
+        perror("gpio: join pthread failed.\n");
 
         return 1;
     }
+    (void)close(gs_stop_fd);
+    gs_stop_fd = -1;
+    
+    /* unlock the memory */
+    if (gs_locked != 0)
+    {
+        (void)munlockall();
+        gs_locked = 0;
+    }
+
+    /* close the gpio */
+    gpiod_chip_close(gs_chip);
+    
+    return 0;
+}
+
+/**
+ * @brief      gpio event init
+ * @param[out] *fd pointer to an event fd buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 init failed
+ * @note       no pthread is created, poll the fd and call gpio_event_read
+ */
+uint8_t gpio_event_init(int *fd)
+{
+    /* open the gpio group */
+    gs_chip = gpiod_chip_open(GPIO_DEVICE_NAME);
+    if (gs_chip == NULL)
+    {
+        perror("gpio: open failed.\n");
+
+        return 1;
+    }
+    
+    /* get the gpio line */
+    gs_line = gpiod_chip_get_line(gs_chip, GPIO_DEVICE_LINE);
+    if (gs_line == NULL) 
+    {
+        perror("gpio: get line failed.\n");
+        gpiod_chip_close(gs_chip);
+
+        return 1;
+    }
+
+    /* catch the falling edge */
+    if (gpiod_line_request_falling_edge_events(gs_line, "gpiointerrupt") < 0)
+    {
+        perror("gpio: set edge events failed.\n");
+        gpiod_chip_close(gs_chip);
+
+        return 1;
+    }
+    
+    /* get the event fd */
+    *fd = gpiod_line_event_get_fd(gs_line);
+    if ((*fd) < 0)
+    {
+        perror("gpio: get fd failed.\n");
+        gpiod_chip_close(gs_chip);
+
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief      gpio event read
+ * @param[out] *timestamp_ns pointer to a kernel timestamp buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 4 not a falling edge
+ * @note       the timestamp is the kernel event time in ns
+ */
+uint8_t gpio_event_read(uint64_t *timestamp_ns)
+{
+    struct gpiod_line_event event;
+    
+    /* read the event */
+    if (gpiod_line_event_read(gs_line, &event) != 0)
+    {
+        perror("gpio: read event failed.\n");
+
+        return 1;
+    }
+    
+    /* if not the falling edge */
+    if (event.event_type != GPIOD_LINE_EVENT_FALLING_EDGE)
+    {
+        return 4;
+    }
+    *timestamp_ns = (uint64_t)event.ts.tv_sec * 1000000000ULL + (uint64_t)event.ts.tv_nsec;
+    
+    return 0;
+}
 
+/**
+ * @brief  gpio event deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t gpio_event_deinit(void)
+{
     /* close the gpio */
     gpiod_chip_close(gs_chip);
     
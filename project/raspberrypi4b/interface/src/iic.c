@@ -226,6 +226,63 @@ uint8_t iic_read_address16(int fd, uint8_t addr, uint16_t reg, uint8_t *buf, uin
     return 0;
 }
 
+/**
+ * @brief      iic bus read of several registers in one transaction
+ * @param[in]  fd iic handle
+ * @param[in]  *addr pointer to an iic device write address array
+ * @param[in]  *reg pointer to an iic register address array
+ * @param[out] *buf pointer to a data buffer of num * len bytes
+ * @param[in]  len length of each read
+ * @param[in]  num read number
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       addr = device_address_7bits << 1, num <= IIC_BATCH_MAX
+ */
+uint8_t iic_read_batch(int fd, uint8_t *addr, uint8_t *reg, uint8_t *buf, uint16_t len, uint8_t num)
+{
+    struct i2c_rdwr_ioctl_data i2c_rdwr_data;
+    struct i2c_msg msgs[IIC_BATCH_MAX * 2];
+    uint8_t i;
+    
+    /* check the num */
+    if ((num == 0) || (num > IIC_BATCH_MAX))
+    {
+        return 1;
+    }
+    
+    /* clear ioctl data */
+    memset(&i2c_rdwr_data, 0, sizeof(struct i2c_rdwr_ioctl_data));
+    
+    /* clear msgs data */
+    memset(msgs, 0, sizeof(struct i2c_msg) * num * 2);
+    
+    /* set the param */
+    for (i = 0; i < num; i++)
+    {
+        msgs[i * 2].addr = addr[i] >> 1;
+        msgs[i * 2].flags = 0;
+        msgs[i * 2].buf = &reg[i];
+        msgs[i * 2].len = 1;
+        msgs[i * 2 + 1].addr = addr[i] >> 1;
+        msgs[i * 2 + 1].flags = I2C_M_RD;
+        msgs[i * 2 + 1].buf = buf + i * len;
+        msgs[i * 2 + 1].len = len;
+    }
+    i2c_rdwr_data.msgs = msgs;
+    i2c_rdwr_data.nmsgs = num * 2;
+    
+    /* transmit */
+    if (ioctl(fd, I2C_RDWR, &i2c_rdwr_data) < 0)
+    {
+        perror("iic: read batch failed.\n");
+        
+        return 1;
+    }
+     
+    return 0;
+}
+
 /**
  * @brief     iic bus write command
  * @param[in] fd iic handle
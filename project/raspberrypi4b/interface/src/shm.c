@@ -0,0 +1,202 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      shm.c
+ * @brief     shm source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "shm.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <string.h>
+
+/**
+ * @brief      shared memory create
+ * @param[in]  *name pointer to a shared memory name buffer
+ * @param[in]  size shared memory size
+ * @param[out] **addr pointer to a mapped address buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 create failed
+ * @note       name must start with '/', the memory is zeroed,
+ *             an existing object with the same name is replaced
+ */
+uint8_t shm_create(char *name, uint32_t size, void **addr)
+{
+    int fd;
+    void *p;
+    
+    /* remove the old object */
+    (void)shm_unlink(name);
+    
+    /* create the object */
+    fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0)
+    {
+        perror("shm: open failed.\n");
+        
+        return 1;
+    }
+    
+    /* set the size */
+    if (ftruncate(fd, size) < 0)
+    {
+        perror("shm: truncate failed.\n");
+        (void)close(fd);
+        (void)shm_unlink(name);
+        
+        return 1;
+    }
+    
+    /* map the object */
+    p = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED)
+    {
+        perror("shm: map failed.\n");
+        (void)close(fd);
+        (void)shm_unlink(name);
+        
+        return 1;
+    }
+    
+    /* the mapping keeps the object */
+    (void)close(fd);
+    
+    /* clear the memory */
+    memset(p, 0, size);
+    *addr = p;
+    
+    return 0;
+}
+
+/**
+ * @brief      shared memory open
+ * @param[in]  *name pointer to a shared memory name buffer
+ * @param[out] **addr pointer to a mapped address buffer
+ * @param[out] *size pointer to a shared memory size buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 open failed
+ * @note       the memory is mapped read only
+ */
+uint8_t shm_open_read(char *name, void **addr, uint32_t *size)
+{
+    int fd;
+    void *p;
+    struct stat st;
+    
+    /* open the object */
+    fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0)
+    {
+        perror("shm: open failed.\n");
+        
+        return 1;
+    }
+    
+    /* get the size */
+    if ((fstat(fd, &st) < 0) || (st.st_size <= 0))
+    {
+        perror("shm: stat failed.\n");
+        (void)close(fd);
+        
+        return 1;
+    }
+    
+    /* map the object */
+    p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED)
+    {
+        perror("shm: map failed.\n");
+        (void)close(fd);
+        
+        return 1;
+    }
+    
+    /* the mapping keeps the object */
+    (void)close(fd);
+    *addr = p;
+    *size = (uint32_t)st.st_size;
+    
+    return 0;
+}
+
+/**
+ * @brief     shared memory close
+ * @param[in] *addr pointer to a mapped address
+ * @param[in] size shared memory size
+ * @return    status code
+ *            - 0 success
+ *            - 1 close failed
+ * @note      none
+ */
+uint8_t shm_close(void *addr, uint32_t size)
+{
+    /* unmap the object */
+    if (munmap(addr, size) < 0)
+    {
+        perror("shm: unmap failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     shared memory destroy
+ * @param[in] *name pointer to a shared memory name buffer
+ * @param[in] *addr pointer to a mapped address
+ * @param[in] size shared memory size
+ * @return    status code
+ *            - 0 success
+ *            - 1 destroy failed
+ * @note      readers keep their mappings until they close them
+ */
+uint8_t shm_destroy(char *name, void *addr, uint32_t size)
+{
+    uint8_t res;
+    
+    /* unmap the object */
+    res = shm_close(addr, size);
+    
+    /* remove the name */
+    if (shm_unlink(name) < 0)
+    {
+        perror("shm: unlink failed.\n");
+        
+        return 1;
+    }
+    
+    return res;
+}
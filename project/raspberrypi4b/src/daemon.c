@@ -0,0 +1,768 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      daemon.c
+ * @brief     daemon source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ina226_interface.h"
+#include "daemon.h"
+#include "gpio.h"
+#include "shm.h"
+#include <getopt.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <sys/signalfd.h>
+
+/**
+ * @brief daemon default definition
+ */
+#define DAEMON_DEFAULT_PERIOD_US                         100000                               /**< 100 ms */
+#define DAEMON_DEFAULT_SIZE                              4096                                 /**< 4096 slots */
+#define DAEMON_DEFAULT_RESISTANCE                        0.1                                  /**< 0.1 ohm */
+#define DAEMON_DEFAULT_AVG_MODE                          INA226_AVG_16                        /**< 16 averages */
+#define DAEMON_DEFAULT_BUS_VOLTAGE_CONVERSION_TIME       INA226_CONVERSION_TIME_1P1_MS        /**< bus voltage conversion time 1.1 ms */
+#define DAEMON_DEFAULT_SHUNT_VOLTAGE_CONVERSION_TIME     INA226_CONVERSION_TIME_1P1_MS        /**< shunt voltage conversion time 1.1 ms */
+#define DAEMON_DEFAULT_SHUNT_VOLTAGE_THRESHOLD           0.8f                                 /**< 0.8 mV */
+#define DAEMON_DEFAULT_BUS_VOLTAGE_THRESHOLD             3300.0f                              /**< 3300 mV */
+#define DAEMON_DEFAULT_POWER_THRESHOLD                   50.0f                                /**< 50 mW */
+
+uint8_t (*g_gpio_irq)(void) = NULL;                                   /**< gpio extern callback */
+uint8_t (*g_gpio_irq_timestamp)(uint64_t timestamp_us) = NULL;        /**< gpio extern timestamp callback */
+static ina226_bus_t gs_bus;                                           /**< bus manager */
+static ina226_bus_frame_t gs_frame;                                   /**< bus frame */
+static ina226_shm_t *gs_shm = NULL;                                   /**< shared memory */
+static uint32_t gs_shm_size = 0;                                      /**< shared memory size */
+static ina226_shm_latest_t *gs_latest = NULL;                         /**< latest shared memory */
+
+/**
+ * @brief     daemon receive callback
+ * @param[in] type irq type
+ * @note      the alert flags are read with ina226_irq_handler_ex
+ */
+static void a_daemon_receive_callback(uint8_t type)
+{
+    (void)type;
+}
+
+/**
+ * @brief      parse the address pin
+ * @param[in]  *str pointer to a string buffer
+ * @param[out] *addr pointer to an address pin buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 parse failed
+ * @note       the address pin is a hex digit from 0 to F
+ */
+static uint8_t a_daemon_parse_addr(const char *str, ina226_address_t *addr)
+{
+    char *end;
+    long pin;
+    
+    /* parse the hex digit */
+    pin = strtol(str, &end, 16);
+    if ((end == str) || (*end != '\0') || (pin < 0) || (pin > 15))
+    {
+        return 1;
+    }
+    *addr = (ina226_address_t)((0x40 + pin) << 1);
+    
+    return 0;
+}
+
+/**
+ * @brief     publish a sample
+ * @param[in] index device index
+ * @param[in] *sample pointer to a sample structure
+ * @note      the slot flags are the mask bits latched since the last sample of the device,
+ *            the float fields are converted here because readers have no handle
+ */
+static void a_daemon_publish(uint8_t index, const ina226_sample_t *sample)
+{
+    uint16_t flags;
+    uint32_t n;
+    ina226_shm_slot_t *slot;
+    ina226_sample_t data;
+    
+    /* convert the float fields */
+    memcpy(&data, sample, sizeof(ina226_sample_t));
+    (void)ina226_sample_convert_to_data(&gs_bus.device[index], &data);
+    
+    /* get and clear the sticky flags */
+    flags = 0;
+    (void)ina226_get_flags(&gs_bus.device[index], &flags, INA226_BOOL_TRUE);
+    
+    /* mark the slot as being written */
+    n = gs_shm->head;
+    slot = &gs_shm->slot[n & (gs_shm->size - 1)];
+    slot->seq = 2 * n + 1;
+    INA226_MEMORY_BARRIER();
+    
+    /* write the slot */
+    slot->device = index;
+    slot->addr = gs_bus.device[index].iic_addr;
+    slot->flags = flags;
+    memcpy(&slot->sample, &data, sizeof(ina226_sample_t));
+    INA226_MEMORY_BARRIER();
+    
+    /* complete the slot and move the head */
+    slot->seq = 2 * n + 2;
+    INA226_MEMORY_BARRIER();
+    gs_shm->head = n + 1;
+    
+    /* update the latest value */
+    (void)ina226_latest_publish(&gs_latest->latest[index], &data, flags);
+}
+
+/**
+ * @brief  run one sweep of all devices
+ * @note   none
+ */
+static void a_daemon_sweep(void)
+{
+    uint8_t i;
+    
+    /* read all devices */
+    (void)ina226_bus_sweep(&gs_bus, &gs_frame);
+    
+    /* publish the valid samples */
+    for (i = 0; i < gs_bus.num; i++)
+    {
+        if ((gs_frame.valid & ((uint32_t)1 << i)) != 0)
+        {
+            a_daemon_publish(i, &gs_frame.sample[i]);
+        }
+        else if ((gs_frame.error & ((uint32_t)1 << i)) != 0)
+        {
+            gs_shm->error++;
+        }
+        else
+        {
+            continue;
+        }
+    }
+    gs_shm->sweep++;
+}
+
+/**
+ * @brief  handle one alert event
+ * @note   the alert line is shared, so every device is asked,
+ *         the edge timestamp is in the get_time_us time base
+ */
+static void a_daemon_alert(void)
+{
+    uint8_t i;
+    uint16_t flags;
+    uint32_t seq;
+    uint64_t timestamp_ns;
+    uint64_t timestamp_us;
+    
+    /* read the event */
+    if (gpio_event_read(&timestamp_ns) != 0)
+    {
+        return;
+    }
+    timestamp_us = timestamp_ns / 1000;
+    
+    /* mark the alert as being written */
+    seq = gs_shm->alert_seq;
+    gs_shm->alert_seq = seq + 1;
+    INA226_MEMORY_BARRIER();
+    
+    /* read the flags of all devices */
+    gs_shm->alert_us = timestamp_us;
+    for (i = 0; i < gs_bus.num; i++)
+    {
+        (void)ina226_set_irq_timestamp(&gs_bus.device[i], timestamp_us);
+        if (ina226_irq_handler_ex(&gs_bus.device[i], &flags) == 0)
+        {
+            gs_shm->flags[i] = flags;
+        }
+    }
+    INA226_MEMORY_BARRIER();
+    
+    /* complete the alert */
+    gs_shm->alert_seq = seq + 2;
+    gs_shm->alert++;
+}
+
+/**
+ * @brief     add a device to the bus
+ * @param[in] addr iic address pin
+ * @param[in] r reference resistor value
+ * @param[in] type alert type, -1 means no alert limit
+ * @param[in] threshold alert threshold
+ * @return    status code
+ *            - 0 success
+ *            - 1 add failed
+ * @note      none
+ */
+static uint8_t a_daemon_add_device(ina226_address_t addr, double r, int type, float threshold)
+{
+    uint8_t res;
+    uint8_t index;
+    uint16_t reg;
+    int i;
+    ina226_handle_t handle;
+    ina226_handle_t *device;
+    ina226_config_t config;
+    
+    /* link interface function */
+    DRIVER_INA226_LINK_INIT(&handle, ina226_handle_t);
+    DRIVER_INA226_LINK_IIC_INIT(&handle, ina226_interface_iic_init);
+    DRIVER_INA226_LINK_IIC_DEINIT(&handle, ina226_interface_iic_deinit);
+    DRIVER_INA226_LINK_IIC_READ(&handle, ina226_interface_iic_read);
+    DRIVER_INA226_LINK_IIC_WRITE(&handle, ina226_interface_iic_write);
+    DRIVER_INA226_LINK_IIC_READ_CMD(&handle, ina226_interface_iic_read_cmd);
+    DRIVER_INA226_LINK_IIC_READ_BATCH(&handle, ina226_interface_iic_read_batch);
+    DRIVER_INA226_LINK_DELAY_MS(&handle, ina226_interface_delay_ms);
+    DRIVER_INA226_LINK_DEBUG_PRINT(&handle, ina226_interface_debug_print);
+    DRIVER_INA226_LINK_GET_TIME_US(&handle, ina226_interface_get_time_us);
+    DRIVER_INA226_LINK_RECEIVE_CALLBACK(&handle, a_daemon_receive_callback);
+    
+    /* set addr pin */
+    res = ina226_set_addr_pin(&handle, addr);
+    if (res != 0)
+    {
+        ina226_interface_debug_print("ina226: set addr pin failed.\n");
+        
+        return 1;
+    }
+    
+    /* set the r */
+    res = ina226_set_resistance(&handle, r);
+    if (res != 0)
+    {
+        ina226_interface_debug_print("ina226: set resistance failed.\n");
+        
+        return 1;
+    }
+    
+    /* add the device */
+    res = ina226_bus_add_device(&gs_bus, &handle, 1, &index);
+    if (res != 0)
+    {
+        ina226_interface_debug_print("ina226: add device failed.\n");
+        
+        return 1;
+    }
+    (void)ina226_bus_get_handle(&gs_bus, index, &device);
+    
+    /* calculate calibration */
+    res = ina226_calculate_calibration(device, (uint16_t *)&config.calibration);
+    if (res != 0)
+    {
+        ina226_interface_debug_print("ina226: calculate calibration failed.\n");
+        
+        return 1;
+    }
+    
+    /* set default config and shunt bus voltage continuous */
+    config.avg = DAEMON_DEFAULT_AVG_MODE;
+    config.bus_voltage_conversion_time = DAEMON_DEFAULT_BUS_VOLTAGE_CONVERSION_TIME;
+    config.shunt_voltage_conversion_time = DAEMON_DEFAULT_SHUNT_VOLTAGE_CONVERSION_TIME;
+    config.mode = INA226_MODE_SHUNT_BUS_VOLTAGE_CONTINUOUS;
+    res = ina226_set_config(device, &config, INA226_BOOL_TRUE);
+    if (res != 0)
+    {
+        ina226_interface_debug_print("ina226: set config failed.\n");
+        
+        return 1;
+    }
+    
+    /* check the alert */
+    if (type < 0)
+    {
+        return 0;
+    }
+    
+    /* check and convert the threshold */
+    if (type < 2)
+    {
+        if ((threshold < -81.92f) || (threshold > 81.9175f))
+        {
+            ina226_interface_debug_print("ina226: shunt voltage threshold is out of -81.92mV - 81.9175mV.\n");
+            
+            return 1;
+        }
+        res = ina226_shunt_voltage_convert_to_register(device, threshold, &reg);
+    }
+    else if (type < 4)
+    {
+        if ((threshold < 0.0f) || (threshold > 40960.0f))
+        {
+            ina226_interface_debug_print("ina226: bus voltage threshold is out of 0mV - 40960mV.\n");
+            
+            return 1;
+        }
+        res = ina226_bus_voltage_convert_to_register(device, threshold, &reg);
+    }
+    else
+    {
+        if ((threshold < 0.0f) || ((double)threshold > device->current_lsb * 25.0 * 1000.0 * 65535.0))
+        {
+            ina226_interface_debug_print("ina226: power threshold is out of range.\n");
+            
+            return 1;
+        }
+        res = ina226_power_convert_to_register(device, threshold, &reg);
+    }
+    if (res != 0)
+    {
+        ina226_interface_debug_print("ina226: convert to register failed.\n");
+        
+        return 1;
+    }
+    
+    /* set the alert limit */
+    res = ina226_set_alert_limit(device, reg);
+    if (res != 0)
+    {
+        ina226_interface_debug_print("ina226: set alert limit failed.\n");
+        
+        return 1;
+    }
+    
+    /* enable only the selected function */
+    for (i = 0; i < 5; i++)
+    {
+        res = ina226_set_mask(device, (ina226_mask_t)(INA226_MASK_SHUNT_VOLTAGE_OVER_VOLTAGE - i),
+                              (i == type) ? INA226_BOOL_TRUE : INA226_BOOL_FALSE);
+        if (res != 0)
+        {
+            ina226_interface_debug_print("ina226: set mask failed.\n");
+            
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  print the help
+ * @note   none
+ */
+static void a_daemon_help(void)
+{
+    ina226_interface_debug_print("Usage:\n");
+    ina226_interface_debug_print("  ina226_daemon [--addr=<0 | 1 | ... | F>] [--resistance=<r>] [--period=<us>]\n");
+    ina226_interface_debug_print("                [--size=<slots>] [--name=<shm>] [--alert] [--type=<0 | 1 | 2 | 3 | 4>]\n");
+    ina226_interface_debug_print("                [--threshold=<value>] [--latest=<shm>]\n");
+    ina226_interface_debug_print("\n");
+    ina226_interface_debug_print("Options:\n");
+    ina226_interface_debug_print("  --addr=<0 | 1 | ... | F>    Set the address pin, repeat it for more devices.([default: 0])\n");
+    ina226_interface_debug_print("  --resistance=<r>            Set the shunt resistance in ohm.([default: 0.1])\n");
+    ina226_interface_debug_print("  --period=<us>               Set the sweep period in us.([default: 100000])\n");
+    ina226_interface_debug_print("  --size=<slots>              Set the shared memory slots, a power of 2.([default: 4096])\n");
+    ina226_interface_debug_print("  --name=<shm>                Set the shared memory name.([default: /ina226])\n");
+    ina226_interface_debug_print("  --latest=<shm>              Set the latest value shared memory name.([default: /ina226_latest])\n");
+    ina226_interface_debug_print("  --alert                     Watch the alert pin and publish the device flags, needs --type.\n");
+    ina226_interface_debug_print("  --type=<0 | 1 | 2 | 3 | 4>  Set the alert type, 0 shunt over, 1 shunt under, 2 bus over,\n");
+    ina226_interface_debug_print("                              3 bus under, 4 power over.\n");
+    ina226_interface_debug_print("  --threshold=<value>         Set the alert threshold in mV or mW.([default: 0.8 for the shunt voltage,\n");
+    ina226_interface_debug_print("                              3300.0 for the bus voltage, 50.0 for the power])\n");
+}
+
+/**
+ * @brief     main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *             - 0 success
+ * @note      none
+ */
+int main(int argc, char **argv)
+{
+    int c;
+    int i;
+    int res;
+    int type = -1;
+    int alert = 0;
+    int threshold_set = 0;
+    int timer_fd = -1;
+    int signal_fd = -1;
+    int gpio_fd = -1;
+    int epoll_fd = -1;
+    int longindex = 0;
+    int ret = 1;
+    uint8_t num = 0;
+    uint32_t size = DAEMON_DEFAULT_SIZE;
+    uint32_t period = DAEMON_DEFAULT_PERIOD_US;
+    uint64_t expirations;
+    double r = DAEMON_DEFAULT_RESISTANCE;
+    float threshold = DAEMON_DEFAULT_BUS_VOLTAGE_THRESHOLD;
+    char name[64] = INA226_SHM_DEFAULT_NAME;
+    char latest[64] = INA226_SHM_LATEST_NAME;
+    ina226_address_t addr[INA226_BUS_MAX_DEVICE];
+    sigset_t mask;
+    struct itimerspec its;
+    struct epoll_event ev;
+    struct epoll_event events[4];
+    const char short_options[] = "h";
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"addr", required_argument, NULL, 1},
+        {"resistance", required_argument, NULL, 2},
+        {"period", required_argument, NULL, 3},
+        {"size", required_argument, NULL, 4},
+        {"name", required_argument, NULL, 5},
+        {"alert", no_argument, NULL, 6},
+        {"type", required_argument, NULL, 7},
+        {"threshold", required_argument, NULL, 8},
+        {"latest", required_argument, NULL, 9},
+        {NULL, 0, NULL, 0},
+    };
+    
+    /* parse */
+    while ((c = getopt_long(argc, argv, short_options, long_options, &longindex)) != -1)
+    {
+        switch (c)
+        {
+            /* addr */
+            case 1 :
+            {
+                if ((num >= INA226_BUS_MAX_DEVICE) || (a_daemon_parse_addr(optarg, &addr[num]) != 0))
+                {
+                    ina226_interface_debug_print("ina226: addr is invalid.\n");
+                    
+                    return 1;
+                }
+                num++;
+                
+                break;
+            }
+            
+            /* resistance */
+            case 2 :
+            {
+                r = atof(optarg);
+                
+                break;
+            }
+            
+            /* period */
+            case 3 :
+            {
+                period = (uint32_t)strtoul(optarg, NULL, 10);
+                
+                break;
+            }
+            
+            /* size */
+            case 4 :
+            {
+                size = (uint32_t)strtoul(optarg, NULL, 10);
+                
+                break;
+            }
+            
+            /* name */
+            case 5 :
+            {
+                snprintf(name, sizeof(name), "%s", optarg);
+                
+                break;
+            }
+            
+            /* alert */
+            case 6 :
+            {
+                alert = 1;
+                
+                break;
+            }
+            
+            /* type */
+            case 7 :
+            {
+                type = atoi(optarg);
+                if ((type < 0) || (type > 4))
+                {
+                    ina226_interface_debug_print("ina226: type is invalid.\n");
+                    
+                    return 1;
+                }
+                
+                break;
+            }
+            
+            /* threshold */
+            case 8 :
+            {
+                threshold = (float)atof(optarg);
+                threshold_set = 1;
+                
+                break;
+            }
+            
+            /* latest */
+            case 9 :
+            {
+                snprintf(latest, sizeof(latest), "%s", optarg);
+                
+                break;
+            }
+            
+            /* help and others */
+            default :
+            {
+                a_daemon_help();
+                
+                return (c == 'h') ? 0 : 1;
+            }
+        }
+    }
+    
+    /* check the params */
+    if ((period == 0) || (size < 2) || ((size & (size - 1)) != 0) || (name[0] != '/') || (latest[0] != '/'))
+    {
+        ina226_interface_debug_print("ina226: param is invalid.\n");
+        
+        return 1;
+    }
+    if (size > (uint32_t)((UINT32_MAX - sizeof(ina226_shm_t)) / sizeof(ina226_shm_slot_t)))
+    {
+        ina226_interface_debug_print("ina226: size is too large.\n");
+        
+        return 1;
+    }
+    if ((alert != 0) && (type < 0))
+    {
+        ina226_interface_debug_print("ina226: alert needs a type.\n");
+        
+        return 1;
+    }
+    if (num == 0)
+    {
+        addr[num++] = INA226_ADDRESS_0;
+    }
+    if (threshold_set == 0)
+    {
+        if ((type == 0) || (type == 1))
+        {
+            threshold = DAEMON_DEFAULT_SHUNT_VOLTAGE_THRESHOLD;
+        }
+        else if (type == 4)
+        {
+            threshold = DAEMON_DEFAULT_POWER_THRESHOLD;
+        }
+        else
+        {
+            threshold = DAEMON_DEFAULT_BUS_VOLTAGE_THRESHOLD;
+        }
+    }
+    
+    /* init the bus and all devices */
+    (void)ina226_bus_init(&gs_bus, ina226_interface_get_time_us);
+    for (i = 0; i < num; i++)
+    {
+        if (a_daemon_add_device(addr[i], r, type, threshold) != 0)
+        {
+            goto exit_bus;
+        }
+    }
+    
+    /* create the shared memory */
+    gs_shm_size = (uint32_t)(sizeof(ina226_shm_t) + size * sizeof(ina226_shm_slot_t));
+    if (shm_create(name, gs_shm_size, (void **)&gs_shm) != 0)
+    {
+        goto exit_bus;
+    }
+    gs_shm->version = INA226_SHM_VERSION;
+    gs_shm->header_size = (uint32_t)sizeof(ina226_shm_t);
+    gs_shm->slot_size = (uint32_t)sizeof(ina226_shm_slot_t);
+    gs_shm->size = size;
+    gs_shm->period_us = period;
+    gs_shm->pid = (uint32_t)getpid();
+    gs_shm->num = num;
+    for (i = 0; i < num; i++)
+    {
+        gs_shm->addr[i] = gs_bus.device[i].iic_addr;
+    }
+    
+    /* create the latest shared memory */
+    if (shm_create(latest, (uint32_t)sizeof(ina226_shm_latest_t), (void **)&gs_latest) != 0)
+    {
+        (void)shm_destroy(name, gs_shm, gs_shm_size);
+        
+        goto exit_bus;
+    }
+    gs_latest->version = INA226_SHM_VERSION;
+    gs_latest->slot_size = (uint32_t)sizeof(ina226_latest_t);
+    gs_latest->num = num;
+    for (i = 0; i < num; i++)
+    {
+        gs_latest->addr[i] = gs_bus.device[i].iic_addr;
+    }
+    gs_shm->running = 1;
+    INA226_MEMORY_BARRIER();
+    gs_latest->magic = INA226_SHM_LATEST_MAGIC;
+    gs_shm->magic = INA226_SHM_MAGIC;
+    
+    /* route the stop signals to a fd */
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGINT);
+    sigaddset(&mask, SIGTERM);
+    (void)sigprocmask(SIG_BLOCK, &mask, NULL);
+    signal_fd = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+    if (signal_fd < 0)
+    {
+        perror("daemon: signalfd failed.\n");
+        
+        goto exit_shm;
+    }
+    
+    /* create the periodic timer */
+    timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (timer_fd < 0)
+    {
+        perror("daemon: timerfd failed.\n");
+        
+        goto exit_fd;
+    }
+    its.it_interval.tv_sec = period / 1000000;
+    its.it_interval.tv_nsec = (long)(period % 1000000) * 1000;
+    its.it_value = its.it_interval;
+    if (timerfd_settime(timer_fd, 0, &its, NULL) < 0)
+    {
+        perror("daemon: timerfd settime failed.\n");
+        
+        goto exit_fd;
+    }
+    
+    /* watch the alert pin */
+    if (alert != 0)
+    {
+        if (gpio_event_init(&gpio_fd) != 0)
+        {
+            goto exit_fd;
+        }
+    }
+    
+    /* add all fds to the epoll */
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd < 0)
+    {
+        perror("daemon: epoll failed.\n");
+        
+        goto exit_fd;
+    }
+    ev.events = EPOLLIN;
+    ev.data.fd = signal_fd;
+    res = epoll_ctl(epoll_fd, EPOLL_CTL_ADD, signal_fd, &ev);
+    ev.data.fd = timer_fd;
+    res |= epoll_ctl(epoll_fd, EPOLL_CTL_ADD, timer_fd, &ev);
+    if (gpio_fd >= 0)
+    {
+        ev.data.fd = gpio_fd;
+        res |= epoll_ctl(epoll_fd, EPOLL_CTL_ADD, gpio_fd, &ev);
+    }
+    if (res != 0)
+    {
+        perror("daemon: epoll ctl failed.\n");
+        
+        goto exit_fd;
+    }
+    
+    /* loop */
+    while (1)
+    {
+        res = epoll_wait(epoll_fd, events, 4, -1);
+        if (res < 0)
+        {
+            continue;
+        }
+        for (i = 0; i < res; i++)
+        {
+            if (events[i].data.fd == signal_fd)
+            {
+                /* stop */
+                ret = 0;
+                
+                goto exit_fd;
+            }
+            else if (events[i].data.fd == gpio_fd)
+            {
+                /* read the alert flags */
+                a_daemon_alert();
+            }
+            else
+            {
+                /* count the missed periods */
+                if (read(timer_fd, &expirations, sizeof(expirations)) != sizeof(expirations))
+                {
+                    continue;
+                }
+                if (expirations > 1)
+                {
+                    gs_shm->missed += (uint32_t)(expirations - 1);
+                }
+                
+                /* run a sweep */
+                a_daemon_sweep();
+            }
+        }
+    }
+    
+    exit_fd:
+    if (epoll_fd >= 0)
+    {
+        (void)close(epoll_fd);
+    }
+    if (gpio_fd >= 0)
+    {
+        (void)gpio_event_deinit();
+    }
+    if (timer_fd >= 0)
+    {
+        (void)close(timer_fd);
+    }
+    if (signal_fd >= 0)
+    {
+        (void)close(signal_fd);
+    }
+    
+    exit_shm:
+    gs_shm->running = 0;
+    (void)shm_destroy(latest, gs_latest, (uint32_t)sizeof(ina226_shm_latest_t));
+    (void)shm_destroy(name, gs_shm, gs_shm_size);
+    
+    exit_bus:
+    (void)ina226_bus_deinit(&gs_bus);
+    
+    return ret;
+}
@@ -0,0 +1,129 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      daemon.h
+ * @brief     daemon header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-18
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/18  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DAEMON_H
+#define DAEMON_H
+
+#include "driver_ina226.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup daemon daemon function
+ * @brief    daemon shared memory layout
+ * @{
+ */
+
+/**
+ * @brief daemon shared memory definition
+ */
+#define INA226_SHM_MAGIC           0x32414E49U        /**< "INA2" */
+#define INA226_SHM_VERSION         1                  /**< layout version */
+#define INA226_SHM_DEFAULT_NAME    "/ina226"          /**< default shared memory name */
+#define INA226_SHM_LATEST_MAGIC    0x544C4E49U        /**< "INLT" */
+#define INA226_SHM_LATEST_NAME     "/ina226_latest"   /**< default latest shared memory name */
+
+/**
+ * @brief daemon shared memory slot structure definition
+ * @note  the writer publishes sample n into slot[n & (size - 1)],
+ *        seq is 2n + 1 while the slot is written and 2n + 2 when it is complete
+ */
+typedef struct ina226_shm_slot_s
+{
+    volatile uint32_t seq;            /**< slot sequence */
+    uint8_t device;                   /**< device index */
+    uint8_t addr;                     /**< device iic address */
+    uint16_t flags;                   /**< mask flags since the last sample */
+    ina226_sample_t sample;           /**< device sample */
+} ina226_shm_slot_t;
+
+/**
+ * @brief daemon shared memory structure definition
+ * @note  a reader keeps its own cursor n, which must satisfy head - size <= n < head,
+ *        reads seq, checks seq == 2n + 2, reads the slot in place, then reads seq again,
+ *        if seq changed the slot was overwritten and the reader skips ahead,
+ *        all counters are 32 bits and wrap, compare them by unsigned difference,
+ *        flags and alert_us are read the same way while alert_seq is even and unchanged
+ */
+typedef struct ina226_shm_s
+{
+    uint32_t magic;                                     /**< layout magic */
+    uint32_t version;                                   /**< layout version */
+    uint32_t header_size;                               /**< header size in bytes */
+    uint32_t slot_size;                                 /**< slot size in bytes */
+    uint32_t size;                                      /**< slot number, power of 2 */
+    uint32_t period_us;                                 /**< sweep period in us */
+    uint32_t pid;                                       /**< daemon pid */
+    uint32_t num;                                       /**< device number */
+    uint8_t addr[INA226_BUS_MAX_DEVICE];                /**< device iic addresses */
+    volatile uint32_t head;                             /**< published sample number */
+    volatile uint32_t sweep;                            /**< sweep number */
+    volatile uint32_t missed;                           /**< missed timer periods */
+    volatile uint32_t error;                            /**< failed device reads */
+    volatile uint32_t alert;                            /**< alert events */
+    volatile uint32_t running;                          /**< daemon running flag */
+    volatile uint16_t flags[INA226_BUS_MAX_DEVICE];     /**< last alert flags */
+    volatile uint32_t alert_seq;                        /**< alert sequence, odd while the alert is written */
+    volatile uint64_t alert_us;                         /**< last alert edge timestamp in us */
+    ina226_shm_slot_t slot[];                           /**< sample slots */
+} ina226_shm_t;
+
+/**
+ * @brief daemon latest shared memory structure definition
+ * @note  device i is read with ina226_latest_read(&latest[i], ...),
+ *        which needs no syscall and no lock
+ */
+typedef struct ina226_shm_latest_s
+{
+    uint32_t magic;                                         /**< layout magic */
+    uint32_t version;                                       /**< layout version */
+    uint32_t slot_size;                                     /**< latest slot size in bytes */
+    uint32_t num;                                           /**< device number */
+    uint8_t addr[INA226_BUS_MAX_DEVICE];                    /**< device iic addresses */
+    ina226_latest_t latest[INA226_BUS_MAX_DEVICE];          /**< device latest samples */
+} ina226_shm_latest_t;
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -44,8 +44,9 @@
 #include <getopt.h>
 #include <stdlib.h>
 
-uint8_t (*g_gpio_irq)(void) = NULL;    /**< gpio extern callback */
-static volatile uint16_t gs_flag;      /**< flag */
+uint8_t (*g_gpio_irq)(void) = NULL;                                   /**< gpio extern callback */
+uint8_t (*g_gpio_irq_timestamp)(uint64_t timestamp_us) = NULL;        /**< gpio extern timestamp callback */
+static volatile uint16_t gs_flag;                                     /**< flag */
 
 /**
  * @brief     interface receive callback
@@ -127,12 +128,18 @@ uint8_t ina226(uint8_t argc, char **argv)
         {"times", required_argument, NULL, 3},
         {"type", required_argument, NULL, 4},
         {"threshold", required_argument, NULL, 5},
+        {"priority", required_argument, NULL, 6},
+        {"cpu", required_argument, NULL, 7},
+        {"mlock", no_argument, NULL, 8},
         {NULL, 0, NULL, 0},
     };
     char type[33] = "unknown";
     uint32_t times = 3;
     double r = 0.1;
     float threshold = 3300.0f;
+    int priority = 0;
+    int cpu = -1;
+    uint8_t lock = 0;
     ina226_mask_t mask = INA226_MASK_BUS_VOLTAGE_OVER_VOLTAGE;
     ina226_address_t addr = INA226_ADDRESS_0;
     
@@ -343,6 +350,33 @@ uint8_t ina226(uint8_t argc, char **argv)
                 break;
             } 
             
+            /* priority */
+            case 6 :
+            {
+                /* set the priority */
+                priority = atoi(optarg);
+                
+                break;
+            } 
+            
+            /* cpu */
+            case 7 :
+            {
+                /* set the cpu */
+                cpu = atoi(optarg);
+                
+                break;
+            } 
+            
+            /* mlock */
+            case 8 :
+            {
+                /* lock the memory */
+                lock = 1;
+                
+                break;
+            } 
+            
             /* the end */
             case -1 :
             {
@@ -356,6 +390,12 @@ uint8_t ina226(uint8_t argc, char **argv)
             }
         }
     } while (c != -1);
+    
+    /* set the interrupt pthread real time settings */
+    if (gpio_interrupt_set_rt(priority, cpu, lock) != 0)
+    {
+        return 5;
+    }
 
     /* run the function */
     if (strcmp("t_reg", type) == 0)
@@ -466,10 +506,27 @@ uint8_t ina226(uint8_t argc, char **argv)
         uint8_t res;
         uint32_t i;
         
+        /* route the conversion ready alert pin */
+        if (INA226_SHOT_DEFAULT_READY_ALERT_PIN == INA226_BOOL_TRUE)
+        {
+            res = gpio_interrupt_init();
+            if (res != 0)
+            {
+                return 1;
+            }
+            g_gpio_irq = ina226_shot_irq_handler;
+        }
+        
         /* shot init */
         res = ina226_shot_init(addr, r);
         if (res != 0)
         {
+            if (INA226_SHOT_DEFAULT_READY_ALERT_PIN == INA226_BOOL_TRUE)
+            {
+                g_gpio_irq = NULL;
+                (void)gpio_interrupt_deinit();
+            }
+            
             return 1;
         }
         
@@ -488,6 +545,11 @@ uint8_t ina226(uint8_t argc, char **argv)
             if (res != 0)
             {
                 (void)ina226_shot_deinit();
+                if (INA226_SHOT_DEFAULT_READY_ALERT_PIN == INA226_BOOL_TRUE)
+                {
+                    g_gpio_irq = NULL;
+                    (void)gpio_interrupt_deinit();
+                }
                 
                 return 1;
             }
@@ -500,6 +562,85 @@ uint8_t ina226(uint8_t argc, char **argv)
             ina226_interface_delay_ms(1000);
         }
         
+        /* shot deinit */
+        (void)ina226_shot_deinit();
+        if (INA226_SHOT_DEFAULT_READY_ALERT_PIN == INA226_BOOL_TRUE)
+        {
+            g_gpio_irq = NULL;
+            (void)gpio_interrupt_deinit();
+        }
+        
+        return 0;
+    }
+    else if (strcmp("e_poll", type) == 0)
+    {
+        uint8_t res;
+        uint32_t i;
+        uint32_t j;
+        
+        /* shot init */
+        res = ina226_shot_init(addr, r);
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        /* delay 1000ms */
+        ina226_interface_delay_ms(1000);
+
+        /* loop */
+        for (i = 0; i < times; i++)
+        {
+            float mV;
+            float mA;
+            float mW;
+            ina226_bool_t ready;
+            
+            /* start a conversion */
+            res = ina226_shot_start();
+            if (res != 0)
+            {
+                (void)ina226_shot_deinit();
+                
+                return 1;
+            }
+            
+            /* poll until the conversion is ready */
+            ready = INA226_BOOL_FALSE;
+            for (j = 0; j < 1000; j++)
+            {
+                res = ina226_shot_poll(&ready);
+                if ((res != 0) || (ready == INA226_BOOL_TRUE))
+                {
+                    break;
+                }
+                ina226_interface_delay_ms(1);
+            }
+            if ((res != 0) || (ready != INA226_BOOL_TRUE))
+            {
+                ina226_interface_debug_print("ina226: poll conversion failed.\n");
+                (void)ina226_shot_deinit();
+                
+                return 1;
+            }
+            
+            /* fetch data */
+            res = ina226_shot_fetch(&mV, &mA, &mW);
+            if (res != 0)
+            {
+                (void)ina226_shot_deinit();
+                
+                return 1;
+            }
+            
+            /* output */
+            ina226_interface_debug_print("ina226: %d/%d polls %d.\n", i + 1, times, j + 1);
+            ina226_interface_debug_print("ina226: bus voltage is %0.3fmV.\n", mV);
+            ina226_interface_debug_print("ina226: current is %0.3fmA.\n", mA);
+            ina226_interface_debug_print("ina226: power is %0.3fmW.\n", mW);
+            ina226_interface_delay_ms(1000);
+        }
+        
         /* shot deinit */
         (void)ina226_shot_deinit();
         
@@ -517,7 +658,7 @@ uint8_t ina226(uint8_t argc, char **argv)
         {
             return 1;
         }
-        g_gpio_irq = ina226_alert_irq_handler;
+        g_gpio_irq_timestamp = ina226_alert_irq_handler_timestamp;
         
         gs_flag = 0;
         if (mask == INA226_MASK_SHUNT_VOLTAGE_OVER_VOLTAGE)
@@ -555,7 +696,7 @@ uint8_t ina226(uint8_t argc, char **argv)
         res = ina226_alert_init(addr, r, mask, threshold, a_receive_callback);
         if (res != 0)
         {
-            g_gpio_irq = NULL;
+            g_gpio_irq_timestamp = NULL;
             (void)gpio_interrupt_deinit();
             
             return 1;
@@ -575,7 +716,7 @@ uint8_t ina226(uint8_t argc, char **argv)
         if (timeout == 0)
         {
             ina226_interface_debug_print("ina226: alert timeout.\n");
-            g_gpio_irq = NULL;
+            g_gpio_irq_timestamp = NULL;
             (void)gpio_interrupt_deinit();
             ina226_alert_deinit();
             
@@ -583,12 +724,55 @@ uint8_t ina226(uint8_t argc, char **argv)
         }
         
         /* alert deinit */
-        g_gpio_irq = NULL;
+        g_gpio_irq_timestamp = NULL;
         (void)gpio_interrupt_deinit();
         (void)ina226_alert_deinit();
         
         return 0;
     }
+    else if (strcmp("e_scan", type) == 0)
+    {
+        uint8_t res;
+        uint8_t i;
+        ina226_handle_t handle;
+        ina226_scan_t scan;
+        
+        /* link interface function */
+        DRIVER_INA226_LINK_INIT(&handle, ina226_handle_t);
+        DRIVER_INA226_LINK_IIC_INIT(&handle, ina226_interface_iic_init);
+        DRIVER_INA226_LINK_IIC_DEINIT(&handle, ina226_interface_iic_deinit);
+        DRIVER_INA226_LINK_IIC_READ(&handle, ina226_interface_iic_read);
+        DRIVER_INA226_LINK_IIC_WRITE(&handle, ina226_interface_iic_write);
+        DRIVER_INA226_LINK_DELAY_MS(&handle, ina226_interface_delay_ms);
+        DRIVER_INA226_LINK_DEBUG_PRINT(&handle, ina226_interface_debug_print);
+        DRIVER_INA226_LINK_RECEIVE_CALLBACK(&handle, ina226_interface_receive_callback);
+        
+        /* scan */
+        res = ina226_scan(&handle, &scan);
+        if (res != 0)
+        {
+            ina226_interface_debug_print("ina226: scan failed.\n");
+            
+            return 1;
+        }
+        
+        /* output */
+        ina226_interface_debug_print("ina226: found %d device(s).\n", scan.num);
+        for (i = 0; i < scan.num; i++)
+        {
+            ina226_interface_debug_print("ina226: addr 0x%02X device id 0x%03X die revision id 0x%X.\n",
+                                         (uint8_t)scan.addr[i] >> 1, scan.device_id[i], scan.die_revision_id[i]);
+        }
+        for (i = 0; i < 16; i++)
+        {
+            if ((scan.other & (1 << i)) != 0)
+            {
+                ina226_interface_debug_print("ina226: addr 0x%02X is another ti part.\n", 0x40 + i);
+            }
+        }
+        
+        return 0;
+    }
     else if (strcmp("h", type) == 0)
     {
         help:
@@ -601,17 +785,22 @@ uint8_t ina226(uint8_t argc, char **argv)
         ina226_interface_debug_print("         [--resistance=<r>] [--times=<num>]\n");
         ina226_interface_debug_print("  ina226 (-t alert | --test=alert) [--addr=<0 | 1 | 2 | 3 | 4 | 5 | 6 | 7 | 8 | 9 | A | B | C | D | E | F>]\n");
         ina226_interface_debug_print("         [--resistance=<r>] [--type=<type>][--threshold=<th>]\n");
+        ina226_interface_debug_print("         [--priority=<n>] [--cpu=<n>] [--mlock]\n");
         ina226_interface_debug_print("  ina226 (-e read | --example=read) [--addr=<0 | 1 | 2 | 3 | 4 | 5 | 6 | 7 | 8 | 9 | A | B | C | D | E | F>]\n");
         ina226_interface_debug_print("         [--resistance=<r>] [--times=<num>]\n");
         ina226_interface_debug_print("  ina226 (-e shot | --example=shot) [--addr=<0 | 1 | 2 | 3 | 4 | 5 | 6 | 7 | 8 | 9 | A | B | C | D | E | F>]\n");
         ina226_interface_debug_print("         [--resistance=<r>] [--times=<num>]\n");
+        ina226_interface_debug_print("  ina226 (-e poll | --example=poll) [--addr=<0 | 1 | 2 | 3 | 4 | 5 | 6 | 7 | 8 | 9 | A | B | C | D | E | F>]\n");
+        ina226_interface_debug_print("         [--resistance=<r>] [--times=<num>]\n");
         ina226_interface_debug_print("  ina226 (-e alert | --example=alert) [--addr=<0 | 1 | 2 | 3 | 4 | 5 | 6 | 7 | 8 | 9 | A | B | C | D | E | F>]\n");
         ina226_interface_debug_print("         [--resistance=<r>] [--type=<type>][--threshold=<th>]\n");
+        ina226_interface_debug_print("         [--priority=<n>] [--cpu=<n>] [--mlock]\n");
+        ina226_interface_debug_print("  ina226 (-e scan | --example=scan)\n");
         ina226_interface_debug_print("\n");
         ina226_interface_debug_print("Options:\n");
         ina226_interface_debug_print("      --addr=<0 | 1 | 2 | 3 | 4 | 5 | 6 | 7 | 8 | 9 | A | B | C | D | E | F>\n");
         ina226_interface_debug_print("                                 Set the addr pin.([default: 0])\n");
-        ina226_interface_debug_print("  -e <read | shot | alert>, --example=<read | shot | alert>\n");
+        ina226_interface_debug_print("  -e <read | shot | poll | alert | scan>, --example=<read | shot | poll | alert | scan>\n");
         ina226_interface_debug_print("                                 Run the driver example.\n");
         ina226_interface_debug_print("  -h, --help                     Show the help.\n");
         ina226_interface_debug_print("  -i, --information              Show the chip information.\n");
@@ -627,6 +816,9 @@ uint8_t ina226(uint8_t argc, char **argv)
         ina226_interface_debug_print("                                 3: bus voltage under voltage;\n");
         ina226_interface_debug_print("                                 4: power over limit.([default: 2])\n");
         ina226_interface_debug_print("      --threshold=<th>           Set alert threshold.([default: 3300.0f])\n");
+        ina226_interface_debug_print("      --priority=<n>             Set the SCHED_FIFO priority of the interrupt thread, 0 keeps the default scheduler.([default: 0])\n");
+        ina226_interface_debug_print("      --cpu=<n>                  Pin the interrupt thread to one cpu, -1 allows any cpu.([default: -1])\n");
+        ina226_interface_debug_print("      --mlock                    Lock all memory with mlockall.\n");
           
         return 0;
     }
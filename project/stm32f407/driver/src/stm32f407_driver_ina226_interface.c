@@ -40,16 +40,42 @@
 #include "uart.h"
 #include <stdarg.h>
 
+/**
+ * @brief conversion ready flag definition
+ */
+static volatile uint8_t gs_ready = 0;        /**< ready flag */
+
+/**
+ * @brief iic reference count definition
+ */
+static uint8_t gs_ref = 0;                   /**< iic reference count */
+
+/**
+ * @brief cycle counter definition
+ */
+static uint8_t gs_cycle_inited = 0;          /**< cycle counter inited flag */
+static uint32_t gs_cycle_last = 0;           /**< last cycle counter value */
+static uint64_t gs_cycle = 0;                /**< extended cycle counter */
+
 /**
  * @brief  interface iic bus init
  * @return status code
  *         - 0 success
  *         - 1 iic init failed
- * @note   none
+ * @note   the bus is shared by all handles and opened once
  */
 uint8_t ina226_interface_iic_init(void)
 {
-    return iic_init();
+    if (gs_ref == 0)
+    {
+        if (iic_init() != 0)
+        {
+            return 1;
+        }
+    }
+    gs_ref++;
+    
+    return 0;
 }
 
 /**
@@ -57,11 +83,21 @@ uint8_t ina226_interface_iic_init(void)
  * @return status code
  *         - 0 success
  *         - 1 iic deinit failed
- * @note   none
+ * @note   the bus is closed by the last handle
  */
 uint8_t ina226_interface_iic_deinit(void)
 {
-    return iic_deinit();
+    if (gs_ref == 0)
+    {
+        return 1;
+    }
+    gs_ref--;
+    if (gs_ref == 0)
+    {
+        return iic_deinit();
+    }
+    
+    return 0;
 }
 
 /**
@@ -96,6 +132,47 @@ uint8_t ina226_interface_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint
     return iic_write(addr, reg, buf, len);
 }
 
+/**
+ * @brief      interface iic bus read without the register address
+ * @param[in]  addr iic device write address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t ina226_interface_iic_read_cmd(uint8_t addr, uint8_t *buf, uint16_t len)
+{
+    return iic_read_cmd(addr, buf, len);
+}
+
+/**
+ * @brief      interface iic bus read of several registers in one transaction
+ * @param[in]  *addr pointer to an iic device write address array
+ * @param[in]  *reg pointer to an iic register address array
+ * @param[out] *buf pointer to a data buffer of num * 2 bytes
+ * @param[in]  num read number
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       each read is 2 bytes
+ */
+uint8_t ina226_interface_iic_read_batch(uint8_t *addr, uint8_t *reg, uint8_t *buf, uint8_t num)
+{
+    uint8_t i;
+    
+    for (i = 0; i < num; i++)
+    {
+        if (iic_read(addr[i], reg[i], buf + i * 2, 2) != 0)
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
 /**
  * @brief     interface delay ms
  * @param[in] ms time
@@ -106,6 +183,16 @@ void ina226_interface_delay_ms(uint32_t ms)
     delay_ms(ms);
 }
 
+/**
+ * @brief     interface delay us
+ * @param[in] us time
+ * @note      none
+ */
+void ina226_interface_delay_us(uint32_t us)
+{
+    delay_us(us);
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
@@ -173,3 +260,66 @@ void ina226_interface_receive_callback(uint8_t type)
         }
     }
 }
+
+/**
+ * @brief     interface wait the conversion ready alert
+ * @param[in] ms timeout in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 wait timeout
+ * @note      none
+ */
+uint8_t ina226_interface_wait_ready(uint32_t ms)
+{
+    uint32_t i;
+    
+    for (i = 0; i < ms * 100; i++)
+    {
+        if (gs_ready != 0)
+        {
+            gs_ready = 0;
+            
+            return 0;
+        }
+        delay_us(10);
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief interface conversion ready notify
+ * @note  call it from the alert pin interrupt
+ */
+void ina226_interface_ready_notify(void)
+{
+    gs_ready = 1;
+}
+
+/**
+ * @brief  interface get time us
+ * @return monotonic time in us
+ * @note   the dwt cycle counter is extended to 64 bits, so it must be called
+ *         at least once per counter wrap, 25s at 168MHz
+ */
+uint64_t ina226_interface_get_time_us(void)
+{
+    uint32_t now;
+    
+    if (gs_cycle_inited == 0)
+    {
+        /* enable the cycle counter */
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+        gs_cycle_last = 0;
+        gs_cycle_inited = 1;
+    }
+    
+    /* extend the counter */
+    now = DWT->CYCCNT;
+    gs_cycle += (uint32_t)(now - gs_cycle_last);
+    gs_cycle_last = now;
+    
+    return gs_cycle / (SystemCoreClock / 1000000);
+}
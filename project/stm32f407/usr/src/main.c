@@ -500,10 +500,27 @@ uint8_t ina226(uint8_t argc, char **argv)
         uint8_t res;
         uint32_t i;
         
+        /* route the conversion ready alert pin */
+        if (INA226_SHOT_DEFAULT_READY_ALERT_PIN == INA226_BOOL_TRUE)
+        {
+            res = gpio_interrupt_init();
+            if (res != 0)
+            {
+                return 1;
+            }
+            g_gpio_irq = ina226_shot_irq_handler;
+        }
+        
         /* shot init */
         res = ina226_shot_init(addr, r);
         if (res != 0)
         {
+            if (INA226_SHOT_DEFAULT_READY_ALERT_PIN == INA226_BOOL_TRUE)
+            {
+                g_gpio_irq = NULL;
+                (void)gpio_interrupt_deinit();
+            }
+            
             return 1;
         }
         
@@ -522,6 +539,11 @@ uint8_t ina226(uint8_t argc, char **argv)
             if (res != 0)
             {
                 (void)ina226_shot_deinit();
+                if (INA226_SHOT_DEFAULT_READY_ALERT_PIN == INA226_BOOL_TRUE)
+                {
+                    g_gpio_irq = NULL;
+                    (void)gpio_interrupt_deinit();
+                }
                 
                 return 1;
             }
@@ -536,6 +558,11 @@ uint8_t ina226(uint8_t argc, char **argv)
         
         /* shot deinit */
         (void)ina226_shot_deinit();
+        if (INA226_SHOT_DEFAULT_READY_ALERT_PIN == INA226_BOOL_TRUE)
+        {
+            g_gpio_irq = NULL;
+            (void)gpio_interrupt_deinit();
+        }
         
         return 0;
     }
@@ -35,7 +35,6 @@
  */
 
 #include "driver_ina226.h" 
-#include <math.h>
 
 /**
  * @brief chip information definition
@@ -63,6 +62,130 @@
 #define INA226_REG_MANUFACTURER         0xFE        /**< manufacturer id register */
 #define INA226_REG_DIE                  0xFF        /**< die id register */
 
+/**
+ * @brief chip register default definition
+ */
+#define INA226_CONF_DEFAULT             0x4127      /**< configuration register power on value */
+#define INA226_MASK_CONFIG_BITS         0xFC03      /**< mask register writable bits */
+
+/**
+ * @brief     update the register shadow
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @param[in] reg iic register address
+ * @param[in] data register data
+ * @note      none
+ */
+static void a_ina226_shadow_update(ina226_handle_t *handle, uint8_t reg, uint16_t data)
+{
+    if (reg == INA226_REG_CONF)                                   /* configuration register */
+    {
+        if ((data & (1 << 15)) != 0)                              /* soft reset restores the defaults */
+        {
+            handle->reg_conf = INA226_CONF_DEFAULT;               /* set conf default */
+            handle->reg_mask = 0x0000;                            /* set mask default */
+            handle->reg_calibration = 0x0000;                     /* set calibration default */
+            handle->reg_alert_limit = 0x0000;                     /* set alert limit default */
+        }
+        else
+        {
+            handle->reg_conf = data;                              /* save conf */
+        }
+    }
+    else if (reg == INA226_REG_MASK)                              /* mask register */
+    {
+        handle->reg_mask = data & INA226_MASK_CONFIG_BITS;        /* save the writable bits */
+    }
+    else if (reg == INA226_REG_CALIBRATION)                       /* calibration register */
+    {
+        handle->reg_calibration = data;                           /* save calibration */
+    }
+    else if (reg == INA226_REG_ALERT_LIMIT)                       /* alert limit register */
+    {
+        handle->reg_alert_limit = data;                           /* save alert limit */
+    }
+    else
+    {
+                                                                  /* do nothing */
+    }
+}
+
+#if (INA226_ENABLE_STATS != 0)
+/**
+ * @brief     get the transfer start time
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @return    start time in us
+ * @note      none
+ */
+static uint64_t a_ina226_stats_start(ina226_handle_t *handle)
+{
+    if (handle->get_time_us != NULL)                 /* check get_time_us */
+    {
+        return handle->get_time_us();                /* return the time */
+    }
+    
+    return 0;                                        /* no time */
+}
+
+/**
+ * @brief     count a transfer
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @param[in] reg register address
+ * @param[in] write write flag
+ * @param[in] res transfer result
+ * @param[in] start transfer start time in us
+ * @note      none
+ */
+static void a_ina226_stats_transfer(ina226_handle_t *handle, uint8_t reg, uint8_t write, uint8_t res, uint64_t start)
+{
+    uint8_t index;
+    uint8_t bin;
+    uint64_t t;
+    
+    index = (reg <= INA226_REG_ALERT_LIMIT) ? reg : 
+            ((reg == INA226_REG_MANUFACTURER) ? 8 : 9);                          /* get the register index */
+    if (write != 0)                                                              /* write */
+    {
+        handle->stats.write[index]++;                                            /* write++ */
+        handle->stats.write_error += (res != 0) ? 1 : 0;                         /* count the error */
+    }
+    else                                                                         /* read */
+    {
+        handle->stats.read[index]++;                                             /* read++ */
+        handle->stats.read_error += (res != 0) ? 1 : 0;                          /* count the error */
+    }
+    if (handle->get_time_us != NULL)                                             /* check get_time_us */
+    {
+        t = handle->get_time_us() - start;                                       /* get the latency */
+        for (bin = 0; (t > 1) && (bin < 31); bin++)                              /* log2 */
+        {
+            t >>= 1;                                                             /* next bin */
+        }
+        handle->stats.latency[bin]++;                                            /* latency++ */
+    }
+}
+#endif
+
+/**
+ * @brief     update the handle state after a register read
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @param[in] reg register address
+ * @param[in] data read data
+ * @note      none
+ */
+static void a_ina226_iic_read_done(ina226_handle_t *handle, uint8_t reg, uint16_t data)
+{
+    handle->pointer = reg;                                                  /* save the pointer */
+    handle->pointer_valid = 1;                                              /* pointer is valid */
+    if (reg == INA226_REG_MASK)                                             /* mask register */
+    {
+        handle->flags |= data & 0x001C;                                     /* latch the sticky flags */
+#if (INA226_ENABLE_STATS != 0)
+        handle->stats.overflow += ((data & (1 << 2)) != 0) ? 1 : 0;         /* count the math overflow */
+#endif
+    }
+    a_ina226_shadow_update(handle, reg, data);                              /* update the shadow */
+}
+
 /**
  * @brief      iic interface read bytes
  * @param[in]  *handle pointer to an ina226 handle structure
@@ -75,16 +198,38 @@
  */
 static uint8_t a_ina226_iic_read(ina226_handle_t *handle, uint8_t reg, uint16_t *data)
 {
+    uint8_t res;
     uint8_t buf[2];
+#if (INA226_ENABLE_STATS != 0)
+    uint64_t start;
+#endif
     
+#if (INA226_ENABLE_STATS != 0)
+    start = a_ina226_stats_start(handle);                                       /* get the start time */
+#endif
     memset(buf, 0, sizeof(uint8_t) * 2);                                        /* clear the buffer */
-    if (handle->iic_read(handle->iic_addr, reg, (uint8_t *)buf, 2) != 0)        /* read data */
+    if ((handle->iic_read_cmd != NULL) && (handle->pointer_valid != 0) && 
+        (handle->pointer == reg))                                               /* check the register pointer */
+    {
+        res = handle->iic_read_cmd(handle->iic_addr, (uint8_t *)buf, 2);        /* read data without pointer */
+    }
+    else
     {
+        res = handle->iic_read(handle->iic_addr, reg, (uint8_t *)buf, 2);       /* read data */
+    }
+#if (INA226_ENABLE_STATS != 0)
+    a_ina226_stats_transfer(handle, reg, 0, res, start);                        /* count the transfer */
+#endif
+    if (res != 0)                                                               /* check result */
+    {
+        handle->pointer_valid = 0;                                              /* pointer is unknown */
+        
         return 1;                                                               /* return error */
     }
     else
     {
         *data = (uint16_t)buf[0] << 8 | buf[1];                                 /* get data */
+        a_ina226_iic_read_done(handle, reg, *data);                             /* update the state */
         
         return 0;                                                               /* success return 0 */
     }
@@ -102,341 +247,656 @@ static uint8_t a_ina226_iic_read(ina226_handle_t *handle, uint8_t reg, uint16_t
  */
 static uint8_t a_ina226_iic_write(ina226_handle_t *handle, uint8_t reg, uint16_t data)
 {
+    uint8_t res;
     uint8_t buf[2];
+#if (INA226_ENABLE_STATS != 0)
+    uint64_t start;
+#endif
     
     buf[0] = (uint8_t)((data >> 8) & 0xFF);                                      /* get MSB */
     buf[1] = (uint8_t)((data >> 0) & 0xFF);                                      /* get LSB */
-    if (handle->iic_write(handle->iic_addr, reg, (uint8_t *)buf, 2) != 0)        /* write data */
-    {
+#if (INA226_ENABLE_STATS != 0)
+    start = a_ina226_stats_start(handle);                                        /* get the start time */
+#endif
+    res = handle->iic_write(handle->iic_addr, reg, (uint8_t *)buf, 2);           /* write data */
+#if (INA226_ENABLE_STATS != 0)
+    a_ina226_stats_transfer(handle, reg, 1, res, start);                         /* count the transfer */
+#endif
+    if (res != 0)                                                                /* check result */
+    {
+        handle->pointer_valid = 0;                                               /* pointer is unknown */
+        
         return 1;                                                                /* return error */
     }
     else
     {
+        handle->pointer = reg;                                                   /* save the pointer */
+        handle->pointer_valid = ((reg == INA226_REG_CONF) && 
+                                 ((data & (1 << 15)) != 0)) ? 0 : 1;             /* reset clears the pointer */
+        a_ina226_shadow_update(handle, reg, data);                               /* update the shadow */
+        
         return 0;                                                                /* success return 0 */
     }
 }
 
 /**
- * @brief     set the resistance
- * @param[in] *handle pointer to an ina226 handle structure
- * @param[in] resistance current sampling resistance value
- * @return    status code
- *            - 0 success
- *            - 2 handle is NULL
- * @note      none
+ * @brief      read registers of one or more devices in one bus transaction
+ * @param[in]  **handle pointer to an ina226 handle array
+ * @param[in]  *reg pointer to a register address array
+ * @param[out] *data pointer to a data array
+ * @param[in]  num item number
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       all handles share the iic_read_batch hook of the first one,
+ *             num <= INA226_READ_BATCH_MAX
  */
-uint8_t ina226_set_resistance(ina226_handle_t *handle, double resistance)
+static uint8_t a_ina226_iic_read_batch(ina226_handle_t **handle, const uint8_t *reg, uint16_t *data, uint8_t num)
 {
-    if (handle == NULL)            /* check handle */
-    {
-        return 2;                  /* return error */
-    }
+    uint8_t i;
+    uint8_t res;
+    uint8_t addr[INA226_READ_BATCH_MAX];
+    uint8_t r[INA226_READ_BATCH_MAX];
+    uint8_t buf[INA226_READ_BATCH_MAX * 2];
+#if (INA226_ENABLE_STATS != 0)
+    uint64_t start;
+#endif
     
-    handle->r = resistance;        /* set resistance */
+    for (i = 0; i < num; i++)                                                    /* set all items */
+    {
+        addr[i] = handle[i]->iic_addr;                                           /* set the address */
+        r[i] = reg[i];                                                           /* set the register */
+    }
+    memset(buf, 0, sizeof(uint8_t) * 2 * num);                                   /* clear the buffer */
+#if (INA226_ENABLE_STATS != 0)
+    start = a_ina226_stats_start(handle[0]);                                     /* get the start time */
+#endif
+    res = handle[0]->iic_read_batch((uint8_t *)addr, (uint8_t *)r, 
+                                    (uint8_t *)buf, num);                        /* read all items */
+    for (i = 0; i < num; i++)                                                    /* update all items */
+    {
+#if (INA226_ENABLE_STATS != 0)
+        a_ina226_stats_transfer(handle[i], reg[i], 0, res, start);               /* count the transfer */
+#endif
+        if (res != 0)                                                            /* check result */
+        {
+            handle[i]->pointer_valid = 0;                                        /* pointer is unknown */
+        }
+        else
+        {
+            data[i] = (uint16_t)buf[i * 2] << 8 | buf[i * 2 + 1];                /* get data */
+            a_ina226_iic_read_done(handle[i], reg[i], data[i]);                  /* update the state */
+        }
+    }
     
-    return 0;                      /* success return 0 */
+    return (res != 0) ? 1 : 0;                                                   /* return the result */
 }
 
 /**
- * @brief      get the resistance
+ * @brief      read a register through the register cache
  * @param[in]  *handle pointer to an ina226 handle structure
- * @param[out] *resistance pointer to a current sampling resistance value buffer
+ * @param[in]  reg iic register address
+ * @param[out] *data pointer to a data buffer
  * @return     status code
  *             - 0 success
- *             - 2 handle is NULL
- * @note       none
+ *             - 1 read failed
+ * @note       only the writable registers are served from the cache
  */
-uint8_t ina226_get_resistance(ina226_handle_t *handle, double *resistance)
+static uint8_t a_ina226_shadow_read(ina226_handle_t *handle, uint8_t reg, uint16_t *data)
 {
-    if (handle == NULL)            /* check handle */
+    if (handle->cache != 0)                             /* check the cache */
     {
-        return 2;                  /* return error */
+        if (reg == INA226_REG_CONF)                     /* configuration register */
+        {
+            *data = handle->reg_conf;                   /* get conf */
+            
+            return 0;                                   /* success return 0 */
+        }
+        else if (reg == INA226_REG_MASK)                /* mask register */
+        {
+            *data = handle->reg_mask;                   /* get mask */
+            
+            return 0;                                   /* success return 0 */
+        }
+        else if (reg == INA226_REG_CALIBRATION)         /* calibration register */
+        {
+            *data = handle->reg_calibration;            /* get calibration */
+            
+            return 0;                                   /* success return 0 */
+        }
+        else if (reg == INA226_REG_ALERT_LIMIT)         /* alert limit register */
+        {
+            *data = handle->reg_alert_limit;            /* get alert limit */
+            
+            return 0;                                   /* success return 0 */
+        }
+        else
+        {
+                                                        /* do nothing */
+        }
     }
     
-    *resistance = handle->r;       /* get resistance */
-    
-    return 0;                      /* success return 0 */
+    return a_ina226_iic_read(handle, reg, data);        /* read data */
 }
 
 /**
- * @brief     set the iic address pin
- * @param[in] *handle pointer to an ina226 handle structure
- * @param[in] addr_pin address pin
- * @return    status code
- *            - 0 success
- *            - 2 handle is NULL
- * @note      none
+ * @brief conversion time table definition
  */
-uint8_t ina226_set_addr_pin(ina226_handle_t *handle, ina226_address_t addr_pin)
+static const uint16_t gs_conversion_time_us[8] =
 {
-    if (handle == NULL)                          /* check handle */
-    {
-        return 2;                                /* return error */
-    }
-    
-    handle->iic_addr = (uint8_t)addr_pin;        /* set pin */
-    
-    return 0;                                    /* success return 0 */
-}
+    140, 204, 332, 588, 1100, 2116, 4156, 8244,
+};
 
 /**
- * @brief      get the iic address pin
- * @param[in]  *handle pointer to an ina226 handle structure
- * @param[out] *addr_pin pointer to an address pin buffer
- * @return     status code
- *             - 0 success
- *             - 2 handle is NULL
- * @note       none
+ * @brief sample register definition
  */
-uint8_t ina226_get_addr_pin(ina226_handle_t *handle, ina226_address_t *addr_pin)
+static const uint8_t gs_sample_reg[6] =
 {
-    if (handle == NULL)                                      /* check handle */
-    {
-        return 2;                                            /* return error */
-    }
-    
-    *addr_pin = (ina226_address_t)(handle->iic_addr);        /* get pin */
-    
-    return 0;                                                /* success return 0 */
-}
+    INA226_REG_SHUNT_VOLTAGE, INA226_REG_BUS_VOLTAGE, INA226_REG_CURRENT, 
+    INA226_REG_POWER, INA226_REG_SHUNT_VOLTAGE, INA226_REG_CURRENT, 
+};
 
 /**
- * @brief     soft reset the chip
+ * @brief average table definition
+ */
+static const uint16_t gs_average[8] =
+{
+    1, 4, 16, 64, 128, 256, 512, 1024,
+};
+
+/**
+ * @brief     get the expected conversion time
  * @param[in] *handle pointer to an ina226 handle structure
- * @return    status code
- *            - 0 success
- *            - 1 soft reset failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @return    conversion time in us
+ * @note      the time is calculated from the conf register shadow
  */
-uint8_t ina226_soft_reset(ina226_handle_t *handle)
+static uint32_t a_ina226_conversion_time_us(ina226_handle_t *handle)
 {
-    uint8_t res;
-    uint16_t prev;
-   
-    if (handle == NULL)                                                        /* check handle */
+    uint32_t t;
+    uint16_t conf;
+    
+    conf = handle->reg_conf;                                  /* get the conf shadow */
+    t = 0;                                                    /* init 0 */
+    if ((conf & (1 << 0)) != 0)                               /* shunt voltage enabled */
     {
-        return 2;                                                              /* return error */
+        t += gs_conversion_time_us[(conf >> 3) & 0x7];        /* add shunt voltage conversion time */
     }
-    if (handle->inited != 1)                                                   /* check handle initialization */
+    if ((conf & (1 << 1)) != 0)                               /* bus voltage enabled */
     {
-        return 3;                                                              /* return error */
+        t += gs_conversion_time_us[(conf >> 6) & 0x7];        /* add bus voltage conversion time */
     }
     
-    res = a_ina226_iic_read(handle, INA226_REG_CONF, (uint16_t *)&prev);       /* read config */
-    if (res != 0)                                                              /* check result */
-    {
-        handle->debug_print("ina226: read conf register failed.\n");           /* read conf register failed */
-       
-        return 1;                                                              /* return error */
-    }
-    prev &= ~(1 << 15);                                                        /* clear soft reset */
-    prev |= 1 << 15;                                                           /* set soft reset */
-
-    return a_ina226_iic_write(handle, INA226_REG_CONF, (uint16_t )prev);       /* write config */
+    return t * gs_average[(conf >> 9) & 0x7];                 /* multiply the average */
 }
 
 /**
- * @brief     set average mode
- * @param[in] *handle pointer to an ina226 handle structure
- * @param[in] mode average mode
- * @return    status code
- *            - 0 success
- *            - 1 set average mode failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief         wait for the conversion ready flag
+ * @param[in]     *handle pointer to an ina226 handle structure
+ * @param[in,out] *prev pointer to the last mask register value
+ * @return        status code
+ *                - 0 success
+ *                - 1 read mask failed
+ *                - 5 read timeout
+ * @note          the wait_ready hook is used when it is linked and the conversion ready
+ *                alert pin is enabled, otherwise the delay_us hook sleeps the expected
+ *                conversion time before checking, else the mask register is polled
  */
-uint8_t ina226_set_average_mode(ina226_handle_t *handle, ina226_avg_t mode)
+static uint8_t a_ina226_wait_conversion_ready(ina226_handle_t *handle, uint16_t *prev)
 {
     uint8_t res;
-    uint16_t prev;
-   
-    if (handle == NULL)                                                        /* check handle */
+    uint16_t i;
+    uint16_t timeout;
+    
+    if (((*prev) & (1 << 3)) != 0)                                                    /* check last mask conversion ready flag */
     {
-        return 2;                                                              /* return error */
+        return 0;                                                                     /* success return 0 */
     }
-    if (handle->inited != 1)                                                   /* check handle initialization */
+    
+    timeout = INA226_READ_TIMEOUT;                                                    /* set timeout */
+    if ((handle->wait_ready != NULL) && ((handle->reg_mask & (1 << 10)) != 0))        /* check wait ready hook */
     {
-        return 3;                                                              /* return error */
+        for (i = 0; i < timeout; i++)                                                 /* loop all */
+        {
+            if (handle->wait_ready(INA226_READ_TIMEOUT) != 0)                         /* wait the alert pin */
+            {
+                break;                                                                /* break */
+            }
+            res = a_ina226_iic_read(handle, INA226_REG_MASK, prev);                   /* read mask */
+            if (res != 0)                                                             /* check result */
+            {
+                handle->debug_print("ina226: read mask register failed.\n");          /* read mask register failed */
+               
+                return 1;                                                             /* return error */
+            }
+            if (((*prev) & (1 << 3)) != 0)                                            /* check conversion ready flag */
+            {
+                return 0;                                                             /* success return 0 */
+            }
+        }
     }
-    
-    res = a_ina226_iic_read(handle, INA226_REG_CONF, (uint16_t *)&prev);       /* read config */
-    if (res != 0)                                                              /* check result */
+    else if (handle->delay_us != NULL)
     {
-        handle->debug_print("ina226: read conf register failed.\n");           /* read conf register failed */
-       
-        return 1;                                                              /* return error */
+        uint32_t t;
+        uint32_t step;
+        uint32_t total;
+        
+        t = a_ina226_conversion_time_us(handle);                                      /* get the conversion time */
+        step = t / 8 + 20;                                                            /* set the poll step */
+        total = t + INA226_READ_TIMEOUT * 1000U;                                      /* set the total time */
+        handle->delay_us(t);                                                          /* wait the conversion */
+        while (1)                                                                     /* loop */
+        {
+            res = a_ina226_iic_read(handle, INA226_REG_MASK, prev);                   /* read mask */
+            if (res != 0)                                                             /* check result */
+            {
+                handle->debug_print("ina226: read mask register failed.\n");          /* read mask register failed */
+               
+                return 1;                                                             /* return error */
+            }
+            if (((*prev) & (1 << 3)) != 0)                                            /* check conversion ready flag */
+            {
+                return 0;                                                             /* success return 0 */
+            }
+            if (t >= total)                                                           /* check timeout */
+            {
+                break;                                                                /* break */
+            }
+            handle->delay_us(step);                                                   /* delay the poll step */
+            t += step;                                                                /* add the step */
+        }
     }
-    prev &= ~(0x7 << 9);                                                       /* clear mode bits */
-    prev |= mode << 9;                                                         /* set mode bits */
-
-    return a_ina226_iic_write(handle, INA226_REG_CONF, (uint16_t )prev);       /* write config */
+    else
+    {
+        for (i = 0; i < timeout; i++)                                                 /* loop all */
+        {
+            res = a_ina226_iic_read(handle, INA226_REG_MASK, prev);                   /* read mask */
+            if (res != 0)                                                             /* check result */
+            {
+                handle->debug_print("ina226: read mask register failed.\n");          /* read mask register failed */
+               
+                return 1;                                                             /* return error */
+            }
+            if (((*prev) & (1 << 3)) != 0)                                            /* check conversion ready flag */
+            {
+                return 0;                                                             /* success return 0 */
+            }
+            handle->delay_ms(1);                                                      /* delay 1ms */
+        }
+    }
+#if (INA226_ENABLE_STATS != 0)
+    handle->stats.timeout++;                                                          /* timeout++ */
+#endif
+    handle->debug_print("ina226: read timeout.\n");                                   /* timeout */
+    
+    return 5;                                                                         /* return error */
 }
 
 /**
- * @brief      get average mode
+ * @brief      read a result register for the fixed point functions
  * @param[in]  *handle pointer to an ina226 handle structure
- * @param[out] *mode pointer to an average mode buffer
+ * @param[in]  reg result register address
+ * @param[in]  *name pointer to the register name
+ * @param[out] *data pointer to a data buffer
  * @return     status code
  *             - 0 success
- *             - 1 get average mode failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
+ *             - 1 read failed
+ *             - 4 math overflow
+ *             - 5 read timeout
  * @note       none
  */
-uint8_t ina226_get_average_mode(ina226_handle_t *handle, ina226_avg_t *mode)
+static uint8_t a_ina226_read_fixed(ina226_handle_t *handle, uint8_t reg, const char *name, uint16_t *data)
 {
     uint8_t res;
     uint16_t prev;
-   
-    if (handle == NULL)                                                        /* check handle */
+    
+    res = a_ina226_iic_read(handle, INA226_REG_MASK, (uint16_t *)&prev);        /* read mask */
+    if (res != 0)                                                               /* check result */
     {
-        return 2;                                                              /* return error */
+        handle->debug_print("ina226: read mask register failed.\n");            /* read mask register failed */
+       
+        return 1;                                                               /* return error */
     }
-    if (handle->inited != 1)                                                   /* check handle initialization */
+    if ((prev & (1 << 2)) != 0)                                                 /* check math overflow */
     {
-        return 3;                                                              /* return error */
+        handle->debug_print("ina226: math overflow.\n");                        /* math overflow */
+       
+        return 4;                                                               /* return error */
+    }
+    if (handle->trigger != 0)                                                   /* trigger mode */
+    {
+        res = a_ina226_wait_conversion_ready(handle, (uint16_t *)&prev);        /* wait conversion ready */
+        if (res != 0)                                                           /* check result */
+        {
+            return res;                                                         /* return error */
+        }
+        handle->trigger = 0;                                                    /* set 0 */
     }
     
-    res = a_ina226_iic_read(handle, INA226_REG_CONF, (uint16_t *)&prev);       /* read config */
-    if (res != 0)                                                              /* check result */
+    res = a_ina226_iic_read(handle, reg, data);                                 /* read result register */
+    if (res != 0)                                                               /* check result */
     {
-        handle->debug_print("ina226: read conf register failed.\n");           /* read conf register failed */
+        handle->debug_print("ina226: read %s register failed.\n", name);        /* read result register failed */
        
-        return 1;                                                              /* return error */
+        return 1;                                                               /* return error */
     }
-    *mode = (ina226_avg_t)((prev >> 9) & 0x07);                                /* get mode */
     
-    return 0;                                                                  /* success return 0 */
+    return 0;                                                                   /* success return 0 */
 }
 
 /**
- * @brief     set bus voltage conversion time
+ * @brief     convert the raw data of a sample in integer
  * @param[in] *handle pointer to an ina226 handle structure
- * @param[in] t conversion time
- * @return    status code
- *            - 0 success
- *            - 1 set bus voltage conversion time failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @param[in] *sample pointer to a sample structure
+ * @note      the float fields are left to ina226_sample_convert_to_data
  */
-uint8_t ina226_set_bus_voltage_conversion_time(ina226_handle_t *handle, ina226_conversion_time_t t)
+static void a_ina226_convert_sample(ina226_handle_t *handle, ina226_sample_t *sample)
 {
-    uint8_t res;
-    uint16_t prev;
-   
-    if (handle == NULL)                                                        /* check handle */
+    sample->shunt_voltage_uV = ((int32_t)(sample->shunt_voltage_raw) * 5) / 2;                /* convert shunt voltage in uV */
+    sample->bus_voltage_uV = (int32_t)(sample->bus_voltage_raw) * 1250;                       /* convert bus voltage in uV */
+    sample->current_uA = (int32_t)(((int64_t)(sample->current_raw) * 
+                                    handle->current_lsb_na) / 1000);                          /* convert current in uA */
+    sample->power_uW = ((int64_t)(sample->power_raw) * 
+                        handle->current_lsb_na * 25) / 1000;                                  /* convert power in uW */
+}
+
+/**
+ * @brief      read the result registers in one bus transaction
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[out] *sample pointer to a sample structure
+ * @param[out] *check pointer to a check buffer of 2 items
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the shunt voltage and current are read again after the results when check is not NULL
+ */
+static uint8_t a_ina226_read_sample_batch(ina226_handle_t *handle, ina226_sample_t *sample, uint16_t *check)
+{
+    uint8_t i;
+    uint8_t num;
+    uint16_t data[6];
+    ina226_handle_t *h[6];
+    
+    num = (check != NULL) ? 6 : 4;                                                      /* set the item number */
+    for (i = 0; i < num; i++)                                                           /* set all items */
     {
-        return 2;                                                              /* return error */
+        h[i] = handle;                                                                  /* set the handle */
     }
-    if (handle->inited != 1)                                                   /* check handle initialization */
+    if (a_ina226_iic_read_batch(h, gs_sample_reg, data, num) != 0)                      /* read all items */
     {
-        return 3;                                                              /* return error */
+        handle->debug_print("ina226: read batch failed.\n");                            /* read batch failed */
+       
+        return 1;                                                                       /* return error */
+    }
+    sample->shunt_voltage_raw = (int16_t)data[0];                                       /* set the shunt voltage raw */
+    sample->bus_voltage_raw = data[1];                                                  /* set the bus voltage raw */
+    sample->current_raw = (int16_t)data[2];                                             /* set the current raw */
+    sample->power_raw = data[3];                                                        /* set the power raw */
+    sample->mixed = 0;                                                                  /* init 0 */
+    if (check != NULL)                                                                  /* check the check buffer */
+    {
+        check[0] = data[4];                                                             /* set the shunt voltage again */
+        check[1] = data[5];                                                             /* set the current again */
     }
+    a_ina226_convert_sample(handle, sample);                                            /* convert the sample */
     
-    res = a_ina226_iic_read(handle, INA226_REG_CONF, (uint16_t *)&prev);       /* read config */
-    if (res != 0)                                                              /* check result */
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief     store the alert edge timestamp
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @param[in] timestamp_us alert edge timestamp in us
+ * @note      single writer, irq_seq is odd while the 64 bits are written
+ */
+static void a_ina226_irq_timestamp_store(ina226_handle_t *handle, uint64_t timestamp_us)
+{
+    uint32_t seq;
+    
+    seq = handle->irq_seq;                          /* get the sequence */
+    handle->irq_seq = seq + 1;                      /* mark as written */
+    INA226_MEMORY_BARRIER();                        /* mark before the data */
+    handle->irq_timestamp_us = timestamp_us;        /* save the timestamp */
+    INA226_MEMORY_BARRIER();                        /* data before the mark */
+    handle->irq_seq = seq + 2;                      /* mark as done */
+}
+
+/**
+ * @brief      load the alert edge timestamp
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[out] *timestamp_us pointer to a timestamp buffer
+ * @param[out] *seq pointer to a sequence buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 load failed
+ * @note       the copy is retried while the writer is inside, so it never tears
+ */
+static uint8_t a_ina226_irq_timestamp_load(ina226_handle_t *handle, uint64_t *timestamp_us, uint32_t *seq)
+{
+    uint32_t i;
+    uint32_t start;
+    uint64_t t;
+    
+    for (i = 0; i < INA226_LATEST_RETRY; i++)                           /* retry */
     {
-        handle->debug_print("ina226: read conf register failed.\n");           /* read conf register failed */
-       
-        return 1;                                                              /* return error */
+        start = handle->irq_seq;                                        /* get the sequence */
+        if ((start & 1) != 0)                                           /* check writing */
+        {
+            continue;                                                   /* try again */
+        }
+        INA226_MEMORY_BARRIER();                                        /* mark before the data */
+        t = handle->irq_timestamp_us;                                   /* copy the timestamp */
+        INA226_MEMORY_BARRIER();                                        /* data before the mark */
+        if (handle->irq_seq == start)                                   /* check unchanged */
+        {
+            *timestamp_us = (start != handle->irq_used) ? t : 0;        /* 0 once consumed */
+            *seq = start;                                               /* set the sequence */
+            
+            return 0;                                                   /* success return 0 */
+        }
     }
-    prev &= ~(7 << 6);                                                         /* clear time bits */
-    prev |= t << 6;                                                            /* set time bits */
+    
+    return 1;                                                           /* return error */
+}
 
-    return a_ina226_iic_write(handle, INA226_REG_CONF, (uint16_t )prev);       /* write config */
+/**
+ * @brief     get the timestamp of a new sample
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @return    timestamp in us
+ * @note      a pending alert edge is taken when the conversion ready alert is enabled
+ */
+static uint64_t a_ina226_sample_timestamp(ina226_handle_t *handle)
+{
+    uint32_t seq;
+    uint64_t t;
+    
+    if (((handle->reg_mask & (1 << 10)) != 0) && 
+        (a_ina226_irq_timestamp_load(handle, &t, &seq) == 0) && (t != 0))        /* check the conversion ready edge */
+    {
+        handle->irq_used = seq;                                                  /* consume it */
+        
+        return t;                                                                /* use the edge timestamp */
+    }
+    if (handle->get_time_us != NULL)                                             /* check get_time_us */
+    {
+        return handle->get_time_us();                                            /* get the time */
+    }
+    
+    return 0;                                                                    /* no timestamp */
 }
 
 /**
- * @brief      get bus voltage conversion time
+ * @brief      read the result registers
  * @param[in]  *handle pointer to an ina226 handle structure
- * @param[out] *t pointer to a conversion time buffer
+ * @param[out] *sample pointer to a sample structure
+ * @param[out] *check pointer to a check buffer of 2 items
  * @return     status code
  *             - 0 success
- *             - 1 get bus voltage conversion time failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ *             - 1 read failed
+ * @note       the shunt voltage and current are read again after the results when check is not NULL
  */
-uint8_t ina226_get_bus_voltage_conversion_time(ina226_handle_t *handle, ina226_conversion_time_t *t)
+static uint8_t a_ina226_read_sample(ina226_handle_t *handle, ina226_sample_t *sample, uint16_t *check)
 {
     uint8_t res;
-    uint16_t prev;
-   
-    if (handle == NULL)                                                        /* check handle */
+    union
     {
-        return 2;                                                              /* return error */
+        uint16_t u;
+        int16_t s;
+    } u;
+    
+    sample->timestamp_us = a_ina226_sample_timestamp(handle);                                 /* set the timestamp */
+    if (handle->iic_read_batch != NULL)                                                       /* check batch hook */
+    {
+        return a_ina226_read_sample_batch(handle, sample, check);                             /* read in one transaction */
     }
-    if (handle->inited != 1)                                                   /* check handle initialization */
+    res = a_ina226_iic_read(handle, INA226_REG_SHUNT_VOLTAGE, (uint16_t *)&u.u);              /* read shunt voltage */
+    if (res != 0)                                                                             /* check result */
     {
-        return 3;                                                              /* return error */
+        handle->debug_print("ina226: read shunt voltage register failed.\n");                 /* read shunt voltage register failed */
+       
+        return 1;                                                                             /* return error */
     }
-    
-    res = a_ina226_iic_read(handle, INA226_REG_CONF, (uint16_t *)&prev);       /* read config */
-    if (res != 0)                                                              /* check result */
+    sample->shunt_voltage_raw = u.s;                                                          /* set the shunt voltage raw */
+    res = a_ina226_iic_read(handle, INA226_REG_BUS_VOLTAGE, 
+                           (uint16_t *)&sample->bus_voltage_raw);                             /* read bus voltage */
+    if (res != 0)                                                                             /* check result */
     {
-        handle->debug_print("ina226: read conf register failed.\n");           /* read conf register failed */
+        handle->debug_print("ina226: read bus voltage register failed.\n");                   /* read bus voltage register failed */
        
-        return 1;                                                              /* return error */
+        return 1;                                                                             /* return error */
     }
-    *t = (ina226_conversion_time_t)((prev >> 6) & 0x07);                       /* get time */
+    res = a_ina226_iic_read(handle, INA226_REG_CURRENT, (uint16_t *)&u.u);                    /* read current */
+    if (res != 0)                                                                             /* check result */
+    {
+        handle->debug_print("ina226: read current register failed.\n");                       /* read current register failed */
+       
+        return 1;                                                                             /* return error */
+    }
+    sample->current_raw = u.s;                                                                /* set the current raw */
+    res = a_ina226_iic_read(handle, INA226_REG_POWER, (uint16_t *)&sample->power_raw);        /* read power */
+    if (res != 0)                                                                             /* check result */
+    {
+        handle->debug_print("ina226: read power register failed.\n");                         /* read power register failed */
+       
+        return 1;                                                                             /* return error */
+    }
+    sample->mixed = 0;                                                                        /* init 0 */
+    if (check != NULL)                                                                        /* check the check buffer */
+    {
+        res = a_ina226_iic_read(handle, INA226_REG_SHUNT_VOLTAGE, &check[0]);                 /* read shunt voltage again */
+        if (res != 0)                                                                         /* check result */
+        {
+            handle->debug_print("ina226: read shunt voltage register failed.\n");             /* read shunt voltage register failed */
+           
+            return 1;                                                                         /* return error */
+        }
+        res = a_ina226_iic_read(handle, INA226_REG_CURRENT, &check[1]);                       /* read current again */
+        if (res != 0)                                                                         /* check result */
+        {
+            handle->debug_print("ina226: read current register failed.\n");                   /* read current register failed */
+           
+            return 1;                                                                         /* return error */
+        }
+    }
+    a_ina226_convert_sample(handle, sample);                                                  /* convert the sample */
     
-    return 0;                                                                  /* success return 0 */
+    return 0;                                                                                 /* success return 0 */
 }
 
 /**
- * @brief     set shunt voltage conversion time
+ * @brief     set the resistance
  * @param[in] *handle pointer to an ina226 handle structure
- * @param[in] t conversion time
+ * @param[in] resistance current sampling resistance value
  * @return    status code
  *            - 0 success
- *            - 1 set shunt voltage conversion time failed
  *            - 2 handle is NULL
- *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t ina226_set_shunt_voltage_conversion_time(ina226_handle_t *handle, ina226_conversion_time_t t)
+uint8_t ina226_set_resistance(ina226_handle_t *handle, double resistance)
 {
-    uint8_t res;
-    uint16_t prev;
-   
-    if (handle == NULL)                                                        /* check handle */
+    if (handle == NULL)            /* check handle */
     {
-        return 2;                                                              /* return error */
+        return 2;                  /* return error */
     }
-    if (handle->inited != 1)                                                   /* check handle initialization */
+    
+    handle->r = resistance;        /* set resistance */
+    
+    return 0;                      /* success return 0 */
+}
+
+/**
+ * @brief      get the resistance
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[out] *resistance pointer to a current sampling resistance value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       none
+ */
+uint8_t ina226_get_resistance(ina226_handle_t *handle, double *resistance)
+{
+    if (handle == NULL)            /* check handle */
     {
-        return 3;                                                              /* return error */
+        return 2;                  /* return error */
     }
     
-    res = a_ina226_iic_read(handle, INA226_REG_CONF, (uint16_t *)&prev);       /* read config */
-    if (res != 0)                                                              /* check result */
+    *resistance = handle->r;       /* get resistance */
+    
+    return 0;                      /* success return 0 */
+}
+
+/**
+ * @brief     set the iic address pin
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @param[in] addr_pin address pin
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      none
+ */
+uint8_t ina226_set_addr_pin(ina226_handle_t *handle, ina226_address_t addr_pin)
+{
+    if (handle == NULL)                          /* check handle */
     {
-        handle->debug_print("ina226: read conf register failed.\n");           /* read conf register failed */
-       
-        return 1;                                                              /* return error */
+        return 2;                                /* return error */
     }
-    prev &= ~(7 << 3);                                                         /* clear time bits */
-    prev |= t << 3;                                                            /* set time bits */
-
-    return a_ina226_iic_write(handle, INA226_REG_CONF, (uint16_t )prev);       /* write config */
+    
+    handle->iic_addr = (uint8_t)addr_pin;        /* set pin */
+    
+    return 0;                                    /* success return 0 */
 }
 
 /**
- * @brief      get shunt voltage conversion time
+ * @brief      get the iic address pin
  * @param[in]  *handle pointer to an ina226 handle structure
- * @param[out] *t pointer to a conversion time buffer
+ * @param[out] *addr_pin pointer to an address pin buffer
  * @return     status code
  *             - 0 success
- *             - 1 get shunt voltage conversion time failed
  *             - 2 handle is NULL
- *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t ina226_get_shunt_voltage_conversion_time(ina226_handle_t *handle, ina226_conversion_time_t *t)
+uint8_t ina226_get_addr_pin(ina226_handle_t *handle, ina226_address_t *addr_pin)
+{
+    if (handle == NULL)                                      /* check handle */
+    {
+        return 2;                                            /* return error */
+    }
+    
+    *addr_pin = (ina226_address_t)(handle->iic_addr);        /* get pin */
+    
+    return 0;                                                /* success return 0 */
+}
+
+/**
+ * @brief     soft reset the chip
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 soft reset failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ina226_soft_reset(ina226_handle_t *handle)
 {
     uint8_t res;
     uint16_t prev;
@@ -450,85 +910,152 @@ uint8_t ina226_get_shunt_voltage_conversion_time(ina226_handle_t *handle, ina226
         return 3;                                                              /* return error */
     }
     
-    res = a_ina226_iic_read(handle, INA226_REG_CONF, (uint16_t *)&prev);       /* read config */
+    res = a_ina226_shadow_read(handle, INA226_REG_CONF, (uint16_t *)&prev);    /* read config */
     if (res != 0)                                                              /* check result */
     {
         handle->debug_print("ina226: read conf register failed.\n");           /* read conf register failed */
        
         return 1;                                                              /* return error */
     }
-    *t = (ina226_conversion_time_t)((prev >> 3) & 0x07);                       /* get time */
-    
-    return 0;                                                                  /* success return 0 */
+    prev &= ~(1 << 15);                                                        /* clear soft reset */
+    prev |= 1 << 15;                                                           /* set soft reset */
+
+    return a_ina226_iic_write(handle, INA226_REG_CONF, (uint16_t )prev);       /* write config */
 }
 
 /**
- * @brief     set the mode
+ * @brief     reload the register cache from the chip
  * @param[in] *handle pointer to an ina226 handle structure
- * @param[in] mode chip mode
  * @return    status code
  *            - 0 success
- *            - 1 set mode failed
+ *            - 1 resync register cache failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t ina226_set_mode(ina226_handle_t *handle, ina226_mode_t mode)
+uint8_t ina226_resync_register_cache(ina226_handle_t *handle)
 {
     uint8_t res;
     uint16_t prev;
-   
-    if (handle == NULL)                                                        /* check handle */
+    
+    if (handle == NULL)                                                                /* check handle */
     {
-        return 2;                                                              /* return error */
+        return 2;                                                                      /* return error */
     }
-    if (handle->inited != 1)                                                   /* check handle initialization */
+    if (handle->inited != 1)                                                           /* check handle initialization */
     {
-        return 3;                                                              /* return error */
+        return 3;                                                                      /* return error */
     }
     
-    res = a_ina226_iic_read(handle, INA226_REG_CONF, (uint16_t *)&prev);       /* read config */
-    if (res != 0)                                                              /* check result */
+    res = a_ina226_iic_read(handle, INA226_REG_CONF, (uint16_t *)&prev);               /* read config */
+    if (res != 0)                                                                      /* check result */
     {
-        handle->debug_print("ina226: read conf register failed.\n");           /* read conf register failed */
+        handle->debug_print("ina226: read conf register failed.\n");                   /* read conf register failed */
        
-        return 1;                                                              /* return error */
+        return 1;                                                                      /* return error */
     }
-    prev &= ~(0x7 << 0);                                                       /* clear mode bit */
-    prev |= mode << 0;                                                         /* set mode bit */
-    res = a_ina226_iic_write(handle, INA226_REG_CONF, (uint16_t )prev);        /* write config */
-    if (res != 0)                                                              /* check result */
+    res = a_ina226_iic_read(handle, INA226_REG_MASK, (uint16_t *)&prev);               /* read mask */
+    if (res != 0)                                                                      /* check result */
     {
-        handle->debug_print("ina226: write conf register failed.\n");          /* write conf register failed */
+        handle->debug_print("ina226: read mask register failed.\n");                   /* read mask register failed */
        
-        return 1;                                                              /* return error */
+        return 1;                                                                      /* return error */
     }
-    if ((mode == INA226_MODE_SHUNT_VOLTAGE_TRIGGERED) ||
-        (mode == INA226_MODE_BUS_VOLTAGE_TRIGGERED) ||
-        (mode == INA226_MODE_SHUNT_BUS_VOLTAGE_TRIGGERED))                     /* check triggered mode */
+    res = a_ina226_iic_read(handle, INA226_REG_CALIBRATION, (uint16_t *)&prev);        /* read calibration */
+    if (res != 0)                                                                      /* check result */
     {
-        handle->trigger = 1;                                                   /* set 1 */
+        handle->debug_print("ina226: read calibration register failed.\n");            /* read calibration register failed */
+       
+        return 1;                                                                      /* return error */
     }
-    else
+    res = a_ina226_iic_read(handle, INA226_REG_ALERT_LIMIT, (uint16_t *)&prev);        /* read alert limit */
+    if (res != 0)                                                                      /* check result */
     {
-        handle->trigger = 0;                                                   /* set 0 */
+        handle->debug_print("ina226: read alert limit register failed.\n");            /* read alert limit register failed */
+       
+        return 1;                                                                      /* return error */
     }
     
-    return 0;                                                                  /* success return 0 */
+    return 0;                                                                          /* success return 0 */
 }
 
 /**
- * @brief      get the mode
+ * @brief     enable or disable the register cache
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set register cache failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the cache is reloaded from the chip when enabled
+ */
+uint8_t ina226_set_register_cache(ina226_handle_t *handle, ina226_bool_t enable)
+{
+    uint8_t res;
+    
+    if (handle == NULL)                                                            /* check handle */
+    {
+        return 2;                                                                  /* return error */
+    }
+    if (handle->inited != 1)                                                       /* check handle initialization */
+    {
+        return 3;                                                                  /* return error */
+    }
+    
+    if (enable == INA226_BOOL_TRUE)                                                /* enable the cache */
+    {
+        res = ina226_resync_register_cache(handle);                                /* reload the cache */
+        if (res != 0)                                                              /* check result */
+        {
+            handle->debug_print("ina226: resync register cache failed.\n");        /* resync register cache failed */
+            
+            return 1;                                                              /* return error */
+        }
+    }
+    handle->cache = (uint8_t)enable;                                               /* set cache */
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief      get the register cache status
  * @param[in]  *handle pointer to an ina226 handle structure
- * @param[out] *mode pointer to a chip mode buffer
+ * @param[out] *enable pointer to a bool value buffer
  * @return     status code
  *             - 0 success
- *             - 1 get mode failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t ina226_get_mode(ina226_handle_t *handle, ina226_mode_t *mode)
+uint8_t ina226_get_register_cache(ina226_handle_t *handle, ina226_bool_t *enable)
+{
+    if (handle == NULL)                              /* check handle */
+    {
+        return 2;                                    /* return error */
+    }
+    if (handle->inited != 1)                         /* check handle initialization */
+    {
+        return 3;                                    /* return error */
+    }
+    
+    *enable = (ina226_bool_t)(handle->cache);        /* get cache */
+    
+    return 0;                                        /* success return 0 */
+}
+
+/**
+ * @brief     set average mode
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @param[in] mode average mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 set average mode failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ina226_set_average_mode(ina226_handle_t *handle, ina226_avg_t mode)
 {
     uint8_t res;
     uint16_t prev;
@@ -542,905 +1069,1071 @@ uint8_t ina226_get_mode(ina226_handle_t *handle, ina226_mode_t *mode)
         return 3;                                                              /* return error */
     }
     
-    res = a_ina226_iic_read(handle, INA226_REG_CONF, (uint16_t *)&prev);       /* read config */
+    res = a_ina226_shadow_read(handle, INA226_REG_CONF, (uint16_t *)&prev);    /* read config */
     if (res != 0)                                                              /* check result */
     {
         handle->debug_print("ina226: read conf register failed.\n");           /* read conf register failed */
        
         return 1;                                                              /* return error */
     }
-    *mode = (ina226_mode_t)((prev >> 0) & 0x7);                                /* get mode */
-    
-    return 0;                                                                  /* success return 0 */
+    prev &= ~(0x7 << 9);                                                       /* clear mode bits */
+    prev |= mode << 9;                                                         /* set mode bits */
+
+    return a_ina226_iic_write(handle, INA226_REG_CONF, (uint16_t )prev);       /* write config */
 }
 
 /**
- * @brief      get the die id
+ * @brief      get average mode
  * @param[in]  *handle pointer to an ina226 handle structure
- * @param[out] *device_id pointer to a device id buffer
- * @param[out] *die_revision_id pointer to a die revision id buffer
+ * @param[out] *mode pointer to an average mode buffer
  * @return     status code
  *             - 0 success
- *             - 1 get die id failed
+ *             - 1 get average mode failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t ina226_get_die_id(ina226_handle_t *handle, uint16_t *device_id, uint8_t *die_revision_id)
+uint8_t ina226_get_average_mode(ina226_handle_t *handle, ina226_avg_t *mode)
 {
     uint8_t res;
     uint16_t prev;
    
-    if (handle == NULL)                                                       /* check handle */
+    if (handle == NULL)                                                        /* check handle */
     {
-        return 2;                                                             /* return error */
+        return 2;                                                              /* return error */
     }
-    if (handle->inited != 1)                                                  /* check handle initialization */
+    if (handle->inited != 1)                                                   /* check handle initialization */
     {
-        return 3;                                                             /* return error */
+        return 3;                                                              /* return error */
     }
     
-    res = a_ina226_iic_read(handle, INA226_REG_DIE, (uint16_t *)&prev);       /* read config */
-    if (res != 0)                                                             /* check result */
+    res = a_ina226_shadow_read(handle, INA226_REG_CONF, (uint16_t *)&prev);    /* read config */
+    if (res != 0)                                                              /* check result */
     {
-        handle->debug_print("ina226: read die register failed.\n");           /* read die register failed */
+        handle->debug_print("ina226: read conf register failed.\n");           /* read conf register failed */
        
-        return 1;                                                             /* return error */
+        return 1;                                                              /* return error */
     }
-    *device_id = (prev >> 4) & 0xFFF;                                         /* get device id */
-    *die_revision_id = prev & 0xF;                                            /* get die revision id */
+    *mode = (ina226_avg_t)((prev >> 9) & 0x07);                                /* get mode */
     
-    return 0;                                                                 /* success return 0 */
+    return 0;                                                                  /* success return 0 */
 }
 
 /**
- * @brief      read the shunt voltage
+ * @brief     set bus voltage conversion time
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @param[in] t conversion time
+ * @return    status code
+ *            - 0 success
+ *            - 1 set bus voltage conversion time failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ina226_set_bus_voltage_conversion_time(ina226_handle_t *handle, ina226_conversion_time_t t)
+{
+    uint8_t res;
+    uint16_t prev;
+   
+    if (handle == NULL)                                                        /* check handle */
+    {
+        return 2;                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                   /* check handle initialization */
+    {
+        return 3;                                                              /* return error */
+    }
+    
+    res = a_ina226_shadow_read(handle, INA226_REG_CONF, (uint16_t *)&prev);    /* read config */
+    if (res != 0)                                                              /* check result */
+    {
+        handle->debug_print("ina226: read conf register failed.\n");           /* read conf register failed */
+       
+        return 1;                                                              /* return error */
+    }
+    prev &= ~(7 << 6);                                                         /* clear time bits */
+    prev |= t << 6;                                                            /* set time bits */
+
+    return a_ina226_iic_write(handle, INA226_REG_CONF, (uint16_t )prev);       /* write config */
+}
+
+/**
+ * @brief      get bus voltage conversion time
  * @param[in]  *handle pointer to an ina226 handle structure
- * @param[out] *raw pointer to raw data buffer
- * @param[out] *mV pointer to converted data buffer
+ * @param[out] *t pointer to a conversion time buffer
  * @return     status code
  *             - 0 success
- *             - 1 read shunt voltage failed
+ *             - 1 get bus voltage conversion time failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- *             - 4 math overflow
- *             - 5 read timeout
  * @note       none
  */
-uint8_t ina226_read_shunt_voltage(ina226_handle_t *handle, int16_t *raw, float *mV)
+uint8_t ina226_get_bus_voltage_conversion_time(ina226_handle_t *handle, ina226_conversion_time_t *t)
 {
     uint8_t res;
-    union
-    {
-        uint16_t u;
-        int16_t s;
-    } u;
     uint16_t prev;
-    
-    if (handle == NULL)                                                                 /* check handle */
+   
+    if (handle == NULL)                                                        /* check handle */
     {
-        return 2;                                                                       /* return error */
+        return 2;                                                              /* return error */
     }
-    if (handle->inited != 1)                                                            /* check handle initialization */
+    if (handle->inited != 1)                                                   /* check handle initialization */
     {
-        return 3;                                                                       /* return error */
+        return 3;                                                              /* return error */
     }
     
-    res = a_ina226_iic_read(handle, INA226_REG_MASK, (uint16_t *)&prev);                /* read mask */
-    if (res != 0)                                                                       /* check result */
+    res = a_ina226_shadow_read(handle, INA226_REG_CONF, (uint16_t *)&prev);    /* read config */
+    if (res != 0)                                                              /* check result */
     {
-        handle->debug_print("ina226: read mask register failed.\n");                    /* read mask register failed */
+        handle->debug_print("ina226: read conf register failed.\n");           /* read conf register failed */
        
-        return 1;                                                                       /* return error */
+        return 1;                                                              /* return error */
     }
-    if ((prev & (1 << 2)) != 0)                                                         /* check math overflow */
+    *t = (ina226_conversion_time_t)((prev >> 6) & 0x07);                       /* get time */
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     set shunt voltage conversion time
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @param[in] t conversion time
+ * @return    status code
+ *            - 0 success
+ *            - 1 set shunt voltage conversion time failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ina226_set_shunt_voltage_conversion_time(ina226_handle_t *handle, ina226_conversion_time_t t)
+{
+    uint8_t res;
+    uint16_t prev;
+   
+    if (handle == NULL)                                                        /* check handle */
     {
-        handle->debug_print("ina226: math overflow.\n");                                /* math overflow */
-       
-        return 4;                                                                       /* return error */
+        return 2;                                                              /* return error */
     }
-    if (handle->trigger != 0)                                                           /* trigger mode */
+    if (handle->inited != 1)                                                   /* check handle initialization */
     {
-        uint16_t i;
-        uint16_t timeout;
-        
-        if ((prev & (1 << 3)) == 0)                                                     /* check last mask conversion ready flag */
-        {
-            timeout = INA226_READ_TIMEOUT;                                              /* set timeout */
-            for (i = 0; i< timeout; i++)                                                /* loop all */
-            {
-                res = a_ina226_iic_read(handle, INA226_REG_MASK, (uint16_t *)&prev);    /* read mask */
-                if (res != 0)                                                           /* check result */
-                {
-                    handle->debug_print("ina226: read mask register failed.\n");        /* read mask register failed */
-                   
-                    return 1;                                                           /* return error */
-                }
-                if ((prev & (1 << 3)) != 0)                                             /* check conversion ready flag */
-                {
-                    break;                                                              /* break */
-                }
-                handle->delay_ms(1);                                                    /* delay 1ms */
-                timeout--;                                                              /* timeout-- */
-            }
-            if (timeout == 0)                                                           /* check timeout */
-            {
-                handle->debug_print("ina226: read timeout.\n");                         /* timeout */
-               
-                return 5;                                                               /* return error */
-            }
-        }
-        handle->trigger = 0;                                                            /* set 0 */
+        return 3;                                                              /* return error */
     }
     
-    res = a_ina226_iic_read(handle, INA226_REG_SHUNT_VOLTAGE, (uint16_t *)&u.u);        /* read shunt voltage */
-    if (res != 0)                                                                       /* check result */
+    res = a_ina226_shadow_read(handle, INA226_REG_CONF, (uint16_t *)&prev);    /* read config */
+    if (res != 0)                                                              /* check result */
     {
-        handle->debug_print("ina226: read shunt voltage register failed.\n");           /* read shunt voltage register failed */
+        handle->debug_print("ina226: read conf register failed.\n");           /* read conf register failed */
        
-        return 1;                                                                       /* return error */
+        return 1;                                                              /* return error */
     }
-    *raw = u.s;                                                                         /* set the raw */
-    *mV = (float)(*raw) / 400.0f;                                                       /* set the converted data */
-    
-    return 0;                                                                           /* success return 0 */
+    prev &= ~(7 << 3);                                                         /* clear time bits */
+    prev |= t << 3;                                                            /* set time bits */
+
+    return a_ina226_iic_write(handle, INA226_REG_CONF, (uint16_t )prev);       /* write config */
 }
 
 /**
- * @brief      read the bus voltage
+ * @brief      get shunt voltage conversion time
  * @param[in]  *handle pointer to an ina226 handle structure
- * @param[out] *raw pointer to raw data buffer
- * @param[out] *mV pointer to converted data buffer
+ * @param[out] *t pointer to a conversion time buffer
  * @return     status code
  *             - 0 success
- *             - 1 read bus voltage failed
+ *             - 1 get shunt voltage conversion time failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- *             - 4 math overflow
- *             - 5 read timeout
  * @note       none
  */
-uint8_t ina226_read_bus_voltage(ina226_handle_t *handle, uint16_t *raw, float *mV)
+uint8_t ina226_get_shunt_voltage_conversion_time(ina226_handle_t *handle, ina226_conversion_time_t *t)
 {
     uint8_t res;
     uint16_t prev;
    
-    if (handle == NULL)                                                                 /* check handle */
+    if (handle == NULL)                                                        /* check handle */
     {
-        return 2;                                                                       /* return error */
+        return 2;                                                              /* return error */
     }
-    if (handle->inited != 1)                                                            /* check handle initialization */
+    if (handle->inited != 1)                                                   /* check handle initialization */
     {
-        return 3;                                                                       /* return error */
-    }
-    
-    res = a_ina226_iic_read(handle, INA226_REG_MASK, (uint16_t *)&prev);                /* read mask */
-    if (res != 0)                                                                       /* check result */
-    {
-        handle->debug_print("ina226: read mask register failed.\n");                    /* read mask register failed */
-       
-        return 1;                                                                       /* return error */
-    }
-    if ((prev & (1 << 2)) != 0)                                                         /* check math overflow */
-    {
-        handle->debug_print("ina226: math overflow.\n");                                /* math overflow */
-       
-        return 4;                                                                       /* return error */
-    }
-    if (handle->trigger != 0)                                                           /* trigger mode */
-    {
-        uint16_t i;
-        uint16_t timeout;
-        
-        if ((prev & (1 << 3)) == 0)                                                     /* check last mask conversion ready flag */
-        {
-            timeout = INA226_READ_TIMEOUT;                                              /* set timeout */
-            for (i = 0; i< timeout; i++)                                                /* loop all */
-            {
-                res = a_ina226_iic_read(handle, INA226_REG_MASK, (uint16_t *)&prev);    /* read mask */
-                if (res != 0)                                                           /* check result */
-                {
-                    handle->debug_print("ina226: read mask register failed.\n");        /* read mask register failed */
-                   
-                    return 1;                                                           /* return error */
-                }
-                if ((prev & (1 << 3)) != 0)                                             /* check conversion ready flag */
-                {
-                    break;                                                              /* break */
-                }
-                handle->delay_ms(1);                                                    /* delay 1ms */
-                timeout--;                                                              /* timeout-- */
-            }
-            if (timeout == 0)                                                           /* check timeout */
-            {
-                handle->debug_print("ina226: read timeout.\n");                         /* timeout */
-               
-                return 5;                                                               /* return error */
-            }
-        }
-        handle->trigger = 0;                                                            /* set 0 */
+        return 3;                                                              /* return error */
     }
     
-    res = a_ina226_iic_read(handle, INA226_REG_BUS_VOLTAGE, (uint16_t *)raw);           /* read bus voltage */
-    if (res != 0)                                                                       /* check result */
+    res = a_ina226_shadow_read(handle, INA226_REG_CONF, (uint16_t *)&prev);    /* read config */
+    if (res != 0)                                                              /* check result */
     {
-        handle->debug_print("ina226: read bus voltage register failed.\n");             /* read bus voltage register failed */
+        handle->debug_print("ina226: read conf register failed.\n");           /* read conf register failed */
        
-        return 1;                                                                       /* return error */
+        return 1;                                                              /* return error */
     }
-    *mV = (float)(*raw) * 1.25f;                                                        /* set the converted data */
+    *t = (ina226_conversion_time_t)((prev >> 3) & 0x07);                       /* get time */
     
-    return 0;                                                                           /* success return 0 */
+    return 0;                                                                  /* success return 0 */
 }
 
 /**
- * @brief      read the current
- * @param[in]  *handle pointer to an ina226 handle structure
- * @param[out] *raw pointer to raw data buffer
- * @param[out] *mA pointer to converted data buffer
- * @return     status code
- *             - 0 success
- *             - 1 read current failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- *             - 4 math overflow
- *             - 5 read timeout
- * @note       none
+ * @brief     set the mode
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @param[in] mode chip mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 set mode failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
  */
-uint8_t ina226_read_current(ina226_handle_t *handle, int16_t *raw, float *mA)
+uint8_t ina226_set_mode(ina226_handle_t *handle, ina226_mode_t mode)
 {
     uint8_t res;
-    union
-    {
-        uint16_t u;
-        int16_t s;
-    } u;
     uint16_t prev;
    
-    if (handle == NULL)                                                                 /* check handle */
+    if (handle == NULL)                                                        /* check handle */
     {
-        return 2;                                                                       /* return error */
+        return 2;                                                              /* return error */
     }
-    if (handle->inited != 1)                                                            /* check handle initialization */
+    if (handle->inited != 1)                                                   /* check handle initialization */
     {
-        return 3;                                                                       /* return error */
+        return 3;                                                              /* return error */
     }
     
-    res = a_ina226_iic_read(handle, INA226_REG_MASK, (uint16_t *)&prev);                /* read mask */
-    if (res != 0)                                                                       /* check result */
+    res = a_ina226_shadow_read(handle, INA226_REG_CONF, (uint16_t *)&prev);    /* read config */
+    if (res != 0)                                                              /* check result */
     {
-        handle->debug_print("ina226: read mask register failed.\n");                    /* read mask register failed */
+        handle->debug_print("ina226: read conf register failed.\n");           /* read conf register failed */
        
-        return 1;                                                                       /* return error */
+        return 1;                                                              /* return error */
     }
-    if ((prev & (1 << 2)) != 0)                                                         /* check math overflow */
+    prev &= ~(0x7 << 0);                                                       /* clear mode bit */
+    prev |= mode << 0;                                                         /* set mode bit */
+    res = a_ina226_iic_write(handle, INA226_REG_CONF, (uint16_t )prev);        /* write config */
+    if (res != 0)                                                              /* check result */
     {
-        handle->debug_print("ina226: math overflow.\n");                                /* math overflow */
+        handle->debug_print("ina226: write conf register failed.\n");          /* write conf register failed */
        
-        return 4;                                                                       /* return error */
+        return 1;                                                              /* return error */
     }
-    if (handle->trigger != 0)                                                           /* trigger mode */
+    if ((mode == INA226_MODE_SHUNT_VOLTAGE_TRIGGERED) ||
+        (mode == INA226_MODE_BUS_VOLTAGE_TRIGGERED) ||
+        (mode == INA226_MODE_SHUNT_BUS_VOLTAGE_TRIGGERED))                     /* check triggered mode */
     {
-        uint16_t i;
-        uint16_t timeout;
-        
-        if ((prev & (1 << 3)) == 0)                                                     /* check last mask conversion ready flag */
-        {
-            timeout = INA226_READ_TIMEOUT;                                              /* set timeout */
-            for (i = 0; i< timeout; i++)                                                /* loop all */
-            {
-                res = a_ina226_iic_read(handle, INA226_REG_MASK, (uint16_t *)&prev);    /* read mask */
-                if (res != 0)                                                           /* check result */
-                {
-                    handle->debug_print("ina226: read mask register failed.\n");        /* read mask register failed */
-                   
-                    return 1;                                                           /* return error */
-                }
-                if ((prev & (1 << 3)) != 0)                                             /* check conversion ready flag */
-                {
-                    break;                                                              /* break */
-                }
-                handle->delay_ms(1);                                                    /* delay 1ms */
-                timeout--;                                                              /* timeout-- */
-            }
-            if (timeout == 0)                                                           /* check timeout */
-            {
-                handle->debug_print("ina226: read timeout.\n");                         /* timeout */
-               
-                return 5;                                                               /* return error */
-            }
-        }
-        handle->trigger = 0;                                                            /* set 0 */
+        handle->trigger = 1;                                                   /* set 1 */
+        handle->finished = 0;                                                  /* not finished */
     }
-    
-    res = a_ina226_iic_read(handle, INA226_REG_CURRENT, (uint16_t *)&u.u);              /* read current */
-    if (res != 0)                                                                       /* check result */
+    else
     {
-        handle->debug_print("ina226: read current register failed.\n");                 /* read current register failed */
-       
-        return 1;                                                                       /* return error */
+        handle->trigger = 0;                                                   /* set 0 */
+        handle->finished = 0;                                                  /* not finished */
     }
-    *raw = u.s;                                                                         /* set the raw */
-    *mA = (float)((double)(*raw) * handle->current_lsb * 1000);                         /* set the converted data */
     
-    return 0;                                                                           /* success return 0 */
+    return 0;                                                                  /* success return 0 */
 }
 
 /**
- * @brief      read the power
+ * @brief      get the mode
  * @param[in]  *handle pointer to an ina226 handle structure
- * @param[out] *raw pointer to raw data buffer
- * @param[out] *mW pointer to converted data buffer
+ * @param[out] *mode pointer to a chip mode buffer
  * @return     status code
  *             - 0 success
- *             - 1 read power failed
+ *             - 1 get mode failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- *             - 4 math overflow
- *             - 5 read timeout
  * @note       none
  */
-uint8_t ina226_read_power(ina226_handle_t *handle, uint16_t *raw, float *mW)
+uint8_t ina226_get_mode(ina226_handle_t *handle, ina226_mode_t *mode)
 {
     uint8_t res;
     uint16_t prev;
    
-    if (handle == NULL)                                                                 /* check handle */
+    if (handle == NULL)                                                        /* check handle */
     {
-        return 2;                                                                       /* return error */
+        return 2;                                                              /* return error */
     }
-    if (handle->inited != 1)                                                            /* check handle initialization */
+    if (handle->inited != 1)                                                   /* check handle initialization */
     {
-        return 3;                                                                       /* return error */
+        return 3;                                                              /* return error */
     }
     
-    res = a_ina226_iic_read(handle, INA226_REG_MASK, (uint16_t *)&prev);                /* read mask */
-    if (res != 0)                                                                       /* check result */
+    res = a_ina226_shadow_read(handle, INA226_REG_CONF, (uint16_t *)&prev);    /* read config */
+    if (res != 0)                                                              /* check result */
     {
-        handle->debug_print("ina226: read mask register failed.\n");                    /* read mask register failed */
+        handle->debug_print("ina226: read conf register failed.\n");           /* read conf register failed */
        
-        return 1;                                                                       /* return error */
+        return 1;                                                              /* return error */
     }
-    if ((prev & (1 << 2)) != 0)                                                         /* check math overflow */
+    *mode = (ina226_mode_t)((prev >> 0) & 0x7);                                /* get mode */
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     set the whole configuration
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @param[in] *config pointer to a config structure
+ * @param[in] verify bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set config failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 verify failed
+ * @note      calibration and conf are written with one transaction each
+ */
+uint8_t ina226_set_config(ina226_handle_t *handle, const ina226_config_t *config, ina226_bool_t verify)
+{
+    uint8_t res;
+    uint16_t conf;
+    uint16_t check;
+    
+    if (handle == NULL)                                                                     /* check handle */
     {
-        handle->debug_print("ina226: math overflow.\n");                                /* math overflow */
-       
-        return 4;                                                                       /* return error */
+        return 2;                                                                           /* return error */
     }
-    if (handle->trigger != 0)                                                           /* trigger mode */
+    if (handle->inited != 1)                                                                /* check handle initialization */
     {
-        uint16_t i;
-        uint16_t timeout;
-        
-        if ((prev & (1 << 3)) == 0)                                                     /* check last mask conversion ready flag */
-        {
-            timeout = INA226_READ_TIMEOUT;                                              /* set timeout */
-            for (i = 0; i< timeout; i++)                                                /* loop all */
-            {
-                res = a_ina226_iic_read(handle, INA226_REG_MASK, (uint16_t *)&prev);    /* read mask */
-                if (res != 0)                                                           /* check result */
-                {
-                    handle->debug_print("ina226: read mask register failed.\n");        /* read mask register failed */
-                   
-                    return 1;                                                           /* return error */
-                }
-                if ((prev & (1 << 3)) != 0)                                             /* check conversion ready flag */
-                {
-                    break;                                                              /* break */
-                }
-                handle->delay_ms(1);                                                    /* delay 1ms */
-                timeout--;                                                              /* timeout-- */
-            }
-            if (timeout == 0)                                                           /* check timeout */
-            {
-                handle->debug_print("ina226: read timeout.\n");                         /* timeout */
-               
-                return 5;                                                               /* return error */
-            }
-        }
-        handle->trigger = 0;                                                            /* set 0 */
+        return 3;                                                                           /* return error */
     }
     
-    res = a_ina226_iic_read(handle, INA226_REG_POWER, (uint16_t *)raw);                 /* read power */
-    if (res != 0)                                                                       /* check result */
+    conf = (uint16_t)(INA226_CONF_DEFAULT & (1 << 14));                                     /* keep reserved bit */
+    conf |= (uint16_t)((config->avg & 0x7) << 9);                                           /* set average mode */
+    conf |= (uint16_t)((config->bus_voltage_conversion_time & 0x7) << 6);                   /* set bus voltage conversion time */
+    conf |= (uint16_t)((config->shunt_voltage_conversion_time & 0x7) << 3);                 /* set shunt voltage conversion time */
+    conf |= (uint16_t)((config->mode & 0x7) << 0);                                          /* set mode */
+    res = a_ina226_iic_write(handle, INA226_REG_CALIBRATION, config->calibration);          /* write calibration */
+    if (res != 0)                                                                           /* check result */
     {
-        handle->debug_print("ina226: read power register failed.\n");                   /* read power register failed */
+        handle->debug_print("ina226: write calibration register failed.\n");                /* write calibration register failed */
        
-        return 1;                                                                       /* return error */
+        return 1;                                                                           /* return error */
+    }
+    res = a_ina226_iic_write(handle, INA226_REG_CONF, conf);                                /* write config */
+    if (res != 0)                                                                           /* check result */
+    {
+        handle->debug_print("ina226: write conf register failed.\n");                       /* write conf register failed */
+       
+        return 1;                                                                           /* return error */
+    }
+    if ((config->mode == INA226_MODE_SHUNT_VOLTAGE_TRIGGERED) ||
+        (config->mode == INA226_MODE_BUS_VOLTAGE_TRIGGERED) ||
+        (config->mode == INA226_MODE_SHUNT_BUS_VOLTAGE_TRIGGERED))                          /* check triggered mode */
+    {
+        handle->trigger = 1;                                                                /* set 1 */
+        handle->finished = 0;                                                               /* not finished */
+    }
+    else
+    {
+        handle->trigger = 0;                                                                /* set 0 */
+        handle->finished = 0;                                                               /* not finished */
+    }
+    if (verify == INA226_BOOL_TRUE)                                                         /* check verify */
+    {
+        res = a_ina226_iic_read(handle, INA226_REG_CALIBRATION, (uint16_t *)&check);        /* read calibration */
+        if (res != 0)                                                                       /* check result */
+        {
+            handle->debug_print("ina226: read calibration register failed.\n");             /* read calibration register failed */
+           
+            return 1;                                                                       /* return error */
+        }
+        if (check != config->calibration)                                                   /* check calibration */
+        {
+            handle->debug_print("ina226: verify calibration register failed.\n");           /* verify calibration register failed */
+           
+            return 4;                                                                       /* return error */
+        }
+        res = a_ina226_iic_read(handle, INA226_REG_CONF, (uint16_t *)&check);               /* read config */
+        if (res != 0)                                                                       /* check result */
+        {
+            handle->debug_print("ina226: read conf register failed.\n");                    /* read conf register failed */
+           
+            return 1;                                                                       /* return error */
+        }
+        if ((check & 0x0FFF) != (conf & 0x0FFF))                                            /* check config */
+        {
+            handle->debug_print("ina226: verify conf register failed.\n");                  /* verify conf register failed */
+           
+            return 4;                                                                       /* return error */
+        }
     }
-    *mW = (float)((double)(*raw) * handle->current_lsb * 25.0 * 1000.0);                /* set the converted data */
     
-    return 0;                                                                           /* success return 0 */
+    return 0;                                                                               /* success return 0 */
 }
 
 /**
- * @brief      get the calibration
+ * @brief      get the whole configuration
  * @param[in]  *handle pointer to an ina226 handle structure
- * @param[out] *data pointer to a calibration data buffer
+ * @param[out] *config pointer to a config structure
  * @return     status code
  *             - 0 success
- *             - 1 get calibration failed
+ *             - 1 get config failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t ina226_get_calibration(ina226_handle_t *handle, uint16_t *data)
+uint8_t ina226_get_config(ina226_handle_t *handle, ina226_config_t *config)
 {
     uint8_t res;
-   
-    if (handle == NULL)                                                              /* check handle */
+    uint16_t conf;
+    
+    if (handle == NULL)                                                                                  /* check handle */
     {
-        return 2;                                                                    /* return error */
+        return 2;                                                                                        /* return error */
     }
-    if (handle->inited != 1)                                                         /* check handle initialization */
+    if (handle->inited != 1)                                                                             /* check handle initialization */
     {
-        return 3;                                                                    /* return error */
+        return 3;                                                                                        /* return error */
     }
     
-    res = a_ina226_iic_read(handle, INA226_REG_CALIBRATION, (uint16_t *)data);       /* read calibration */
-    if (res != 0)                                                                    /* check result */
+    res = a_ina226_shadow_read(handle, INA226_REG_CONF, (uint16_t *)&conf);                              /* read config */
+    if (res != 0)                                                                                        /* check result */
     {
-        handle->debug_print("ina226: read calibration register failed.\n");          /* read calibration register failed */
+        handle->debug_print("ina226: read conf register failed.\n");                                     /* read conf register failed */
        
-        return 1;                                                                    /* return error */
+        return 1;                                                                                        /* return error */
+    }
+    res = a_ina226_shadow_read(handle, INA226_REG_CALIBRATION, (uint16_t *)&config->calibration);        /* read calibration */
+    if (res != 0)                                                                                        /* check result */
+    {
+        handle->debug_print("ina226: read calibration register failed.\n");                              /* read calibration register failed */
+       
+        return 1;                                                                                        /* return error */
     }
+    config->avg = (ina226_avg_t)((conf >> 9) & 0x7);                                                     /* get average mode */
+    config->bus_voltage_conversion_time = (ina226_conversion_time_t)((conf >> 6) & 0x7);                 /* get bus voltage conversion time */
+    config->shunt_voltage_conversion_time = (ina226_conversion_time_t)((conf >> 3) & 0x7);               /* get shunt voltage conversion time */
+    config->mode = (ina226_mode_t)((conf >> 0) & 0x7);                                                   /* get mode */
     
-    return 0;                                                                        /* success return 0 */
+    return 0;                                                                                            /* success return 0 */
 }
 
 /**
- * @brief      calculate the calibration
+ * @brief      get the die id
  * @param[in]  *handle pointer to an ina226 handle structure
- * @param[out] *calibration pointer to a calibration data buffer
+ * @param[out] *device_id pointer to a device id buffer
+ * @param[out] *die_revision_id pointer to a die revision id buffer
  * @return     status code
  *             - 0 success
- *             - 1 calculate calibration failed
+ *             - 1 get die id failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- *             - 4 r can't be zero
  * @note       none
  */
-uint8_t ina226_calculate_calibration(ina226_handle_t *handle, uint16_t *calibration)
+uint8_t ina226_get_die_id(ina226_handle_t *handle, uint16_t *device_id, uint8_t *die_revision_id)
 {
-    double v;
+    uint8_t res;
+    uint16_t prev;
    
-    if (handle == NULL)                                                /* check handle */
+    if (handle == NULL)                                                       /* check handle */
     {
-        return 2;                                                      /* return error */
+        return 2;                                                             /* return error */
     }
-    if (handle->inited != 1)                                           /* check handle initialization */
+    if (handle->inited != 1)                                                  /* check handle initialization */
     {
-        return 3;                                                      /* return error */
+        return 3;                                                             /* return error */
     }
-    if ((handle->r >= -0.000001f)  && (handle->r <= 0.000001f))        /* check the r */
+    
+    res = a_ina226_iic_read(handle, INA226_REG_DIE, (uint16_t *)&prev);       /* read config */
+    if (res != 0)                                                             /* check result */
     {
-        handle->debug_print("ina226: r can't be zero.\n");             /* r can't be zero */
+        handle->debug_print("ina226: read die register failed.\n");           /* read die register failed */
        
-        return 4;                                                      /* return error */
+        return 1;                                                             /* return error */
     }
+    *device_id = (prev >> 4) & 0xFFF;                                         /* get device id */
+    *die_revision_id = prev & 0xF;                                            /* get die revision id */
     
-    v = 0.08192;                                                       /* set max range */
-    handle->current_lsb = v / handle->r / pow(2.0, 15.0);              /* current lsb */
-    *calibration = (uint16_t)(0.00512 / (v / pow(2.0, 15.0)));         /* set calibration */
-    
-    return 0;                                                          /* success return 0 */
+    return 0;                                                                 /* success return 0 */
 }
 
 /**
- * @brief     set the calibration
- * @param[in] *handle pointer to an ina226 handle structure
- * @param[in] data calibration data
- * @return    status code
- *            - 0 success
- *            - 1 set calibration failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief      scan all ina226 addresses on the bus
+ * @param[in]  *handle pointer to a linked ina226 handle structure
+ * @param[out] *scan pointer to a scan structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 iic init failed
+ *             - 2 handle or scan is NULL
+ *             - 3 linked functions is NULL
+ * @note       the handle doesn't need to be initialized and the chips are not reset,
+ *             other ti parts sharing the manufacturer id are only set in the other mask
  */
-uint8_t ina226_set_calibration(ina226_handle_t *handle, uint16_t data)
+uint8_t ina226_scan(ina226_handle_t *handle, ina226_scan_t *scan)
 {
-    uint8_t res;
-   
-    if (handle == NULL)                                                             /* check handle */
+    uint8_t i;
+    uint8_t addr;
+    uint8_t buf[2];
+    uint16_t prev;
+    
+    if ((handle == NULL) || (scan == NULL))                                      /* check handle and scan */
     {
-        return 2;                                                                   /* return error */
+        return 2;                                                                /* return error */
     }
-    if (handle->inited != 1)                                                        /* check handle initialization */
+    if ((handle->iic_init == NULL) || (handle->iic_deinit == NULL) || 
+        (handle->iic_read == NULL))                                              /* check linked functions */
     {
-        return 3;                                                                   /* return error */
+        return 3;                                                                /* return error */
     }
     
-    res = a_ina226_iic_write(handle, INA226_REG_CALIBRATION, data);                 /* write calibration */
-    if (res != 0)                                                                   /* check result */
+    if (handle->iic_init() != 0)                                                 /* iic init */
     {
-        handle->debug_print("ina226: write calibration register failed.\n");        /* write calibration register failed */
-       
-        return 1;                                                                   /* return error */
+        return 1;                                                                /* return error */
     }
+    memset(scan, 0, sizeof(ina226_scan_t));                                      /* clear the scan */
+    for (i = 0; i < 16; i++)                                                     /* loop all addresses */
+    {
+        addr = (uint8_t)((0x40 + i) << 1);                                       /* set the address */
+        if (handle->iic_read(addr, INA226_REG_MANUFACTURER, buf, 2) != 0)        /* read manufacturer */
+        {
+            continue;                                                            /* no device */
+        }
+        prev = (uint16_t)(((uint16_t)buf[0] << 8) | buf[1]);                     /* get the id */
+        if (prev != 0x5449)                                                      /* check id */
+        {
+            continue;                                                            /* not an ina226 */
+        }
+        if (handle->iic_read(addr, INA226_REG_DIE, buf, 2) != 0)                 /* read die */
+        {
+            continue;                                                            /* read failed */
+        }
+        prev = (uint16_t)(((uint16_t)buf[0] << 8) | buf[1]);                     /* get the die */
+        if (((prev >> 4) & 0xFFF) != 0x226)                                      /* check device id */
+        {
+            scan->other |= (uint16_t)(1 << i);                                   /* set other */
+            
+            continue;                                                            /* another ti part */
+        }
+        scan->found |= (uint16_t)(1 << i);                                       /* set found */
+        scan->addr[scan->num] = (ina226_address_t)addr;                          /* set the address */
+        scan->device_id[scan->num] = (prev >> 4) & 0xFFF;                        /* set device id */
+        scan->die_revision_id[scan->num] = prev & 0xF;                           /* set die revision id */
+        scan->num++;                                                             /* num++ */
+    }
+    handle->pointer_valid = 0;                                                   /* pointer is unknown */
+    (void)handle->iic_deinit();                                                  /* iic deinit */
     
-    return 0;                                                                       /* success return 0 */
+    return 0;                                                                    /* success return 0 */
 }
 
 /**
- * @brief     enable or disable mask
- * @param[in] *handle pointer to an ina226 handle structure
- * @param[in] mask set mask
- * @param[in] enable bool value
- * @return    status code
- *            - 0 success
- *            - 1 set mask failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief      read the shunt voltage
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[out] *raw pointer to raw data buffer
+ * @param[out] *mV pointer to converted data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read shunt voltage failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 math overflow
+ *             - 5 read timeout
+ * @note       none
  */
-uint8_t ina226_set_mask(ina226_handle_t *handle, ina226_mask_t mask, ina226_bool_t enable)
+uint8_t ina226_read_shunt_voltage(ina226_handle_t *handle, int16_t *raw, float *mV)
 {
     uint8_t res;
+    union
+    {
+        uint16_t u;
+        int16_t s;
+    } u;
     uint16_t prev;
-   
-    if (handle == NULL)                                                         /* check handle */
+    
+    if (handle == NULL)                                                                 /* check handle */
     {
-        return 2;                                                               /* return error */
+        return 2;                                                                       /* return error */
     }
-    if (handle->inited != 1)                                                    /* check handle initialization */
+    if (handle->inited != 1)                                                            /* check handle initialization */
     {
-        return 3;                                                               /* return error */
+        return 3;                                                                       /* return error */
     }
     
-    res = a_ina226_iic_read(handle, INA226_REG_MASK, (uint16_t *)&prev);        /* read mask */
-    if (res != 0)                                                               /* check result */
+    res = a_ina226_iic_read(handle, INA226_REG_MASK, (uint16_t *)&prev);                /* read mask */
+    if (res != 0)                                                                       /* check result */
     {
-        handle->debug_print("ina226: read mask register failed.\n");            /* read mask register failed */
+        handle->debug_print("ina226: read mask register failed.\n");                    /* read mask register failed */
        
-        return 1;                                                               /* return error */
+        return 1;                                                                       /* return error */
     }
-    prev &= ~(1 << mask);                                                       /* clear settings */
-    prev |= (enable << mask);                                                   /* set mask */
-    res = a_ina226_iic_write(handle, INA226_REG_MASK, prev);                    /* write mask */
-    if (res != 0)                                                               /* check result */
+    if ((prev & (1 << 2)) != 0)                                                         /* check math overflow */
     {
-        handle->debug_print("ina226: write mask register failed.\n");           /* write mask register failed */
+        handle->debug_print("ina226: math overflow.\n");                                /* math overflow */
        
-        return 1;                                                               /* return error */
+        return 4;                                                                       /* return error */
+    }
+    if (handle->trigger != 0)                                                           /* trigger mode */
+    {
+        res = a_ina226_wait_conversion_ready(handle, (uint16_t *)&prev);                /* wait conversion ready */
+        if (res != 0)                                                                   /* check result */
+        {
+            return res;                                                                 /* return error */
+        }
+        handle->trigger = 0;                                                            /* set 0 */
     }
     
-    return 0;                                                                   /* success return 0 */
+    res = a_ina226_iic_read(handle, INA226_REG_SHUNT_VOLTAGE, (uint16_t *)&u.u);        /* read shunt voltage */
+    if (res != 0)                                                                       /* check result */
+    {
+        handle->debug_print("ina226: read shunt voltage register failed.\n");           /* read shunt voltage register failed */
+       
+        return 1;                                                                       /* return error */
+    }
+    *raw = u.s;                                                                         /* set the raw */
+    *mV = (float)(*raw) / 400.0f;                                                       /* set the converted data */
+    
+    return 0;                                                                           /* success return 0 */
 }
 
 /**
- * @brief      get mask
+ * @brief      read the shunt voltage
  * @param[in]  *handle pointer to an ina226 handle structure
- * @param[in]  mask set mask
- * @param[out] *enable pointer to a bool value buffer
+ * @param[out] *raw pointer to raw data buffer
+ * @param[out] *uV pointer to converted data buffer
  * @return     status code
  *             - 0 success
- *             - 1 get mask failed
+ *             - 1 read shunt voltage failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- * @note       none
+ *             - 4 math overflow
+ *             - 5 read timeout
+ * @note       integer conversion in uV
  */
-uint8_t ina226_get_mask(ina226_handle_t *handle, ina226_mask_t mask, ina226_bool_t *enable)
+uint8_t ina226_read_shunt_voltage_fixed(ina226_handle_t *handle, int16_t *raw, int32_t *uV)
 {
     uint8_t res;
-    uint16_t prev;
-   
-    if (handle == NULL)                                                         /* check handle */
+    union
     {
-        return 2;                                                               /* return error */
+        uint16_t u;
+        int16_t s;
+    } u;
+    
+    if (handle == NULL)                                                                        /* check handle */
+    {
+        return 2;                                                                              /* return error */
     }
-    if (handle->inited != 1)                                                    /* check handle initialization */
+    if (handle->inited != 1)                                                                   /* check handle initialization */
     {
-        return 3;                                                               /* return error */
+        return 3;                                                                              /* return error */
     }
     
-    res = a_ina226_iic_read(handle, INA226_REG_MASK, (uint16_t *)&prev);        /* read mask */
-    if (res != 0)                                                               /* check result */
+    res = a_ina226_read_fixed(handle, INA226_REG_SHUNT_VOLTAGE, "shunt voltage", &u.u);        /* read shunt voltage */
+    if (res != 0)                                                                              /* check result */
     {
-        handle->debug_print("ina226: read mask register failed.\n");            /* read mask register failed */
-       
-        return 1;                                                               /* return error */
+        return res;                                                                            /* return error */
     }
-    *enable = (ina226_bool_t)((prev >> mask) & 0x01);                           /* get bool */
+    *raw = u.s;                                                                                /* set the raw */
+    *uV = ((int32_t)(*raw) * 5) / 2;                                                           /* set the converted data */
     
-    return 0;                                                                   /* success return 0 */
+    return 0;                                                                                  /* success return 0 */
 }
 
 /**
- * @brief     enable or disable conversion ready alert pin
- * @param[in] *handle pointer to an ina226 handle structure
- * @param[in] enable bool value
- * @return    status code
- *            - 0 success
- *            - 1 set conversion ready alert pin failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief      read the bus voltage
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[out] *raw pointer to raw data buffer
+ * @param[out] *mV pointer to converted data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read bus voltage failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 math overflow
+ *             - 5 read timeout
+ * @note       none
  */
-uint8_t ina226_set_conversion_ready_alert_pin(ina226_handle_t *handle, ina226_bool_t enable)
+uint8_t ina226_read_bus_voltage(ina226_handle_t *handle, uint16_t *raw, float *mV)
 {
     uint8_t res;
     uint16_t prev;
    
-    if (handle == NULL)                                                         /* check handle */
+    if (handle == NULL)                                                                 /* check handle */
     {
-        return 2;                                                               /* return error */
+        return 2;                                                                       /* return error */
     }
-    if (handle->inited != 1)                                                    /* check handle initialization */
+    if (handle->inited != 1)                                                            /* check handle initialization */
     {
-        return 3;                                                               /* return error */
+        return 3;                                                                       /* return error */
     }
     
-    res = a_ina226_iic_read(handle, INA226_REG_MASK, (uint16_t *)&prev);        /* read mask */
-    if (res != 0)                                                               /* check result */
+    res = a_ina226_iic_read(handle, INA226_REG_MASK, (uint16_t *)&prev);                /* read mask */
+    if (res != 0)                                                                       /* check result */
     {
-        handle->debug_print("ina226: read mask register failed.\n");            /* read mask register failed */
+        handle->debug_print("ina226: read mask register failed.\n");                    /* read mask register failed */
        
-        return 1;                                                               /* return error */
+        return 1;                                                                       /* return error */
     }
-    prev &= ~(1 << 10);                                                         /* clear settings */
-    prev |= (enable << 10);                                                     /* set mask */
-    res = a_ina226_iic_write(handle, INA226_REG_MASK, prev);                    /* write mask */
-    if (res != 0)                                                               /* check result */
+    if ((prev & (1 << 2)) != 0)                                                         /* check math overflow */
     {
-        handle->debug_print("ina226: write mask register failed.\n");           /* write mask register failed */
+        handle->debug_print("ina226: math overflow.\n");                                /* math overflow */
        
-        return 1;                                                               /* return error */
+        return 4;                                                                       /* return error */
+    }
+    if (handle->trigger != 0)                                                           /* trigger mode */
+    {
+        res = a_ina226_wait_conversion_ready(handle, (uint16_t *)&prev);                /* wait conversion ready */
+        if (res != 0)                                                                   /* check result */
+        {
+            return res;                                                                 /* return error */
+        }
+        handle->trigger = 0;                                                            /* set 0 */
     }
     
-    return 0;                                                                   /* success return 0 */
+    res = a_ina226_iic_read(handle, INA226_REG_BUS_VOLTAGE, (uint16_t *)raw);           /* read bus voltage */
+    if (res != 0)                                                                       /* check result */
+    {
+        handle->debug_print("ina226: read bus voltage register failed.\n");             /* read bus voltage register failed */
+       
+        return 1;                                                                       /* return error */
+    }
+    *mV = (float)(*raw) * 1.25f;                                                        /* set the converted data */
+    
+    return 0;                                                                           /* success return 0 */
 }
 
 /**
- * @brief      get conversion ready alert pin status
+ * @brief      read the bus voltage
  * @param[in]  *handle pointer to an ina226 handle structure
- * @param[out] *enable pointer to a bool value buffer
+ * @param[out] *raw pointer to raw data buffer
+ * @param[out] *uV pointer to converted data buffer
  * @return     status code
  *             - 0 success
- *             - 1 get conversion ready alert pin failed
+ *             - 1 read bus voltage failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- * @note       none
+ *             - 4 math overflow
+ *             - 5 read timeout
+ * @note       integer conversion in uV
  */
-uint8_t ina226_get_conversion_ready_alert_pin(ina226_handle_t *handle, ina226_bool_t *enable)
+uint8_t ina226_read_bus_voltage_fixed(ina226_handle_t *handle, uint16_t *raw, int32_t *uV)
 {
     uint8_t res;
-    uint16_t prev;
    
-    if (handle == NULL)                                                         /* check handle */
+    if (handle == NULL)                                                                   /* check handle */
     {
-        return 2;                                                               /* return error */
+        return 2;                                                                         /* return error */
     }
-    if (handle->inited != 1)                                                    /* check handle initialization */
+    if (handle->inited != 1)                                                              /* check handle initialization */
     {
-        return 3;                                                               /* return error */
+        return 3;                                                                         /* return error */
     }
     
-    res = a_ina226_iic_read(handle, INA226_REG_MASK, (uint16_t *)&prev);        /* read mask */
-    if (res != 0)                                                               /* check result */
+    res = a_ina226_read_fixed(handle, INA226_REG_BUS_VOLTAGE, "bus voltage", raw);        /* read bus voltage */
+    if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("ina226: read mask register failed.\n");            /* read mask register failed */
-       
-        return 1;                                                               /* return error */
+        return res;                                                                       /* return error */
     }
-    *enable = (ina226_bool_t)((prev >> 10) & 0x01);                             /* get bool */
+    *uV = (int32_t)(*raw) * 1250;                                                         /* set the converted data */
     
-    return 0;                                                                   /* success return 0 */
+    return 0;                                                                             /* success return 0 */
 }
 
 /**
- * @brief     set alert polarity pin
- * @param[in] *handle pointer to an ina226 handle structure
- * @param[in] pin alert polarity pin
- * @return    status code
- *            - 0 success
- *            - 1 set alert polarity pin failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
- */
-uint8_t ina226_set_alert_polarity_pin(ina226_handle_t *handle, ina226_alert_polarity_t pin)
-{
-    uint8_t res;
-    uint16_t prev;
-   
-    if (handle == NULL)                                                         /* check handle */
+ * @brief      read the current
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[out] *raw pointer to raw data buffer
+ * @param[out] *mA pointer to converted data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read current failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 math overflow
+ *             - 5 read timeout
+ * @note       none
+ */
+uint8_t ina226_read_current(ina226_handle_t *handle, int16_t *raw, float *mA)
+{
+    uint8_t res;
+    union
     {
-        return 2;                                                               /* return error */
+        uint16_t u;
+        int16_t s;
+    } u;
+    uint16_t prev;
+   
+    if (handle == NULL)                                                                 /* check handle */
+    {
+        return 2;                                                                       /* return error */
     }
-    if (handle->inited != 1)                                                    /* check handle initialization */
+    if (handle->inited != 1)                                                            /* check handle initialization */
     {
-        return 3;                                                               /* return error */
+        return 3;                                                                       /* return error */
     }
     
-    res = a_ina226_iic_read(handle, INA226_REG_MASK, (uint16_t *)&prev);        /* read mask */
-    if (res != 0)                                                               /* check result */
+    res = a_ina226_iic_read(handle, INA226_REG_MASK, (uint16_t *)&prev);                /* read mask */
+    if (res != 0)                                                                       /* check result */
     {
-        handle->debug_print("ina226: read mask register failed.\n");            /* read mask register failed */
+        handle->debug_print("ina226: read mask register failed.\n");                    /* read mask register failed */
        
-        return 1;                                                               /* return error */
+        return 1;                                                                       /* return error */
     }
-    prev &= ~(1 << 1);                                                          /* clear settings */
-    prev |= (pin << 1);                                                         /* set mask */
-    res = a_ina226_iic_write(handle, INA226_REG_MASK, prev);                    /* write mask */
-    if (res != 0)                                                               /* check result */
+    if ((prev & (1 << 2)) != 0)                                                         /* check math overflow */
     {
-        handle->debug_print("ina226: write mask register failed.\n");           /* write mask register failed */
+        handle->debug_print("ina226: math overflow.\n");                                /* math overflow */
        
-        return 1;                                                               /* return error */
+        return 4;                                                                       /* return error */
+    }
+    if (handle->trigger != 0)                                                           /* trigger mode */
+    {
+        res = a_ina226_wait_conversion_ready(handle, (uint16_t *)&prev);                /* wait conversion ready */
+        if (res != 0)                                                                   /* check result */
+        {
+            return res;                                                                 /* return error */
+        }
+        handle->trigger = 0;                                                            /* set 0 */
     }
     
-    return 0;                                                                   /* success return 0 */
+    res = a_ina226_iic_read(handle, INA226_REG_CURRENT, (uint16_t *)&u.u);              /* read current */
+    if (res != 0)                                                                       /* check result */
+    {
+        handle->debug_print("ina226: read current register failed.\n");                 /* read current register failed */
+       
+        return 1;                                                                       /* return error */
+    }
+    *raw = u.s;                                                                         /* set the raw */
+    *mA = (float)((double)(*raw) * handle->current_lsb * 1000);                         /* set the converted data */
+    
+    return 0;                                                                           /* success return 0 */
 }
 
 /**
- * @brief      get alert polarity pin
+ * @brief      read the current
  * @param[in]  *handle pointer to an ina226 handle structure
- * @param[out] *pin pointer to an alert polarity pin buffer
+ * @param[out] *raw pointer to raw data buffer
+ * @param[out] *uA pointer to converted data buffer
  * @return     status code
  *             - 0 success
- *             - 1 get alert polarity pin failed
+ *             - 1 read current failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- * @note       none
+ *             - 4 math overflow
+ *             - 5 read timeout
+ * @note       integer conversion in uA
  */
-uint8_t ina226_get_alert_polarity_pin(ina226_handle_t *handle, ina226_alert_polarity_t *pin)
+uint8_t ina226_read_current_fixed(ina226_handle_t *handle, int16_t *raw, int32_t *uA)
 {
     uint8_t res;
-    uint16_t prev;
+    union
+    {
+        uint16_t u;
+        int16_t s;
+    } u;
    
-    if (handle == NULL)                                                         /* check handle */
+    if (handle == NULL)                                                            /* check handle */
     {
-        return 2;                                                               /* return error */
+        return 2;                                                                  /* return error */
     }
-    if (handle->inited != 1)                                                    /* check handle initialization */
+    if (handle->inited != 1)                                                       /* check handle initialization */
     {
-        return 3;                                                               /* return error */
+        return 3;                                                                  /* return error */
     }
     
-    res = a_ina226_iic_read(handle, INA226_REG_MASK, (uint16_t *)&prev);        /* read mask */
-    if (res != 0)                                                               /* check result */
+    res = a_ina226_read_fixed(handle, INA226_REG_CURRENT, "current", &u.u);        /* read current */
+    if (res != 0)                                                                  /* check result */
     {
-        handle->debug_print("ina226: read mask register failed.\n");            /* read mask register failed */
-       
-        return 1;                                                               /* return error */
+        return res;                                                                /* return error */
     }
-    *pin = (ina226_alert_polarity_t)((prev >> 1) & 0x01);                       /* get alert polarity pin */
+    *raw = u.s;                                                                    /* set the raw */
+    *uA = (int32_t)(((int64_t)(*raw) * handle->current_lsb_na) / 1000);            /* set the converted data */
     
-    return 0;                                                                   /* success return 0 */
+    return 0;                                                                      /* success return 0 */
 }
 
 /**
- * @brief     enable or disable alert latch
- * @param[in] *handle pointer to an ina226 handle structure
- * @param[in] enable bool value
- * @return    status code
- *            - 0 success
- *            - 1 set alert latch failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief      read the power
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[out] *raw pointer to raw data buffer
+ * @param[out] *mW pointer to converted data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read power failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 math overflow
+ *             - 5 read timeout
+ * @note       none
  */
-uint8_t ina226_set_alert_latch(ina226_handle_t *handle, ina226_bool_t enable)
+uint8_t ina226_read_power(ina226_handle_t *handle, uint16_t *raw, float *mW)
 {
     uint8_t res;
     uint16_t prev;
    
-    if (handle == NULL)                                                         /* check handle */
+    if (handle == NULL)                                                                 /* check handle */
     {
-        return 2;                                                               /* return error */
+        return 2;                                                                       /* return error */
     }
-    if (handle->inited != 1)                                                    /* check handle initialization */
+    if (handle->inited != 1)                                                            /* check handle initialization */
     {
-        return 3;                                                               /* return error */
+        return 3;                                                                       /* return error */
     }
     
-    res = a_ina226_iic_read(handle, INA226_REG_MASK, (uint16_t *)&prev);        /* read mask */
-    if (res != 0)                                                               /* check result */
+    res = a_ina226_iic_read(handle, INA226_REG_MASK, (uint16_t *)&prev);                /* read mask */
+    if (res != 0)                                                                       /* check result */
     {
-        handle->debug_print("ina226: read mask register failed.\n");            /* read mask register failed */
+        handle->debug_print("ina226: read mask register failed.\n");                    /* read mask register failed */
        
-        return 1;                                                               /* return error */
+        return 1;                                                                       /* return error */
     }
-    prev &= ~(1 << 0);                                                          /* clear settings */
-    prev |= (enable << 0);                                                      /* set mask */
-    res = a_ina226_iic_write(handle, INA226_REG_MASK, prev);                    /* write mask */
-    if (res != 0)                                                               /* check result */
+    if ((prev & (1 << 2)) != 0)                                                         /* check math overflow */
     {
-        handle->debug_print("ina226: write mask register failed.\n");           /* write mask register failed */
+        handle->debug_print("ina226: math overflow.\n");                                /* math overflow */
        
-        return 1;                                                               /* return error */
+        return 4;                                                                       /* return error */
+    }
+    if (handle->trigger != 0)                                                           /* trigger mode */
+    {
+        res = a_ina226_wait_conversion_ready(handle, (uint16_t *)&prev);                /* wait conversion ready */
+        if (res != 0)                                                                   /* check result */
+        {
+            return res;                                                                 /* return error */
+        }
+        handle->trigger = 0;                                                            /* set 0 */
     }
     
-    return 0;                                                                   /* success return 0 */
+    res = a_ina226_iic_read(handle, INA226_REG_POWER, (uint16_t *)raw);                 /* read power */
+    if (res != 0)                                                                       /* check result */
+    {
+        handle->debug_print("ina226: read power register failed.\n");                   /* read power register failed */
+       
+        return 1;                                                                       /* return error */
+    }
+    *mW = (float)((double)(*raw) * handle->current_lsb * 25.0 * 1000.0);                /* set the converted data */
+    
+    return 0;                                                                           /* success return 0 */
 }
 
 /**
- * @brief      get alert latch status
+ * @brief      read the power
  * @param[in]  *handle pointer to an ina226 handle structure
- * @param[out] *enable pointer to a bool value buffer
+ * @param[out] *raw pointer to raw data buffer
+ * @param[out] *uW pointer to converted data buffer
  * @return     status code
  *             - 0 success
- *             - 1 get alert latch failed
+ *             - 1 read power failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- * @note       none
+ *             - 4 math overflow
+ *             - 5 read timeout
+ * @note       integer conversion in uW
  */
-uint8_t ina226_get_alert_latch(ina226_handle_t *handle, ina226_bool_t *enable)
+uint8_t ina226_read_power_fixed(ina226_handle_t *handle, uint16_t *raw, int64_t *uW)
 {
     uint8_t res;
-    uint16_t prev;
    
-    if (handle == NULL)                                                         /* check handle */
+    if (handle == NULL)                                                       /* check handle */
     {
-        return 2;                                                               /* return error */
+        return 2;                                                             /* return error */
     }
-    if (handle->inited != 1)                                                    /* check handle initialization */
+    if (handle->inited != 1)                                                  /* check handle initialization */
     {
-        return 3;                                                               /* return error */
+        return 3;                                                             /* return error */
     }
     
-    res = a_ina226_iic_read(handle, INA226_REG_MASK, (uint16_t *)&prev);        /* read mask */
-    if (res != 0)                                                               /* check result */
+    res = a_ina226_read_fixed(handle, INA226_REG_POWER, "power", raw);        /* read power */
+    if (res != 0)                                                             /* check result */
     {
-        handle->debug_print("ina226: read mask register failed.\n");            /* read mask register failed */
-       
-        return 1;                                                               /* return error */
+        return res;                                                           /* return error */
     }
-    *enable = (ina226_bool_t)((prev >> 0) & 0x01);                              /* get bool */
+    *uW = ((int64_t)(*raw) * handle->current_lsb_na * 25) / 1000;             /* set the converted data */
     
-    return 0;                                                                   /* success return 0 */
+    return 0;                                                                 /* success return 0 */
 }
 
 /**
- * @brief     set alert limit
- * @param[in] *handle pointer to an ina226 handle structure
- * @param[in] reg set register
- * @return    status code
- *            - 0 success
- *            - 1 set alert limit failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief      read shunt voltage, bus voltage, current and power of one conversion
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[out] *sample pointer to a sample structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read all failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 math overflow
+ *             - 5 read timeout
+ * @note       the shunt voltage and current are read again after the four result registers,
+ *             the read is retried if they changed, the last read is kept with mixed set
+ *             when all INA226_READ_ALL_RETRY reads changed
  */
-uint8_t ina226_set_alert_limit(ina226_handle_t *handle, uint16_t reg)
+uint8_t ina226_read_all(ina226_handle_t *handle, ina226_sample_t *sample)
 {
     uint8_t res;
-   
-    if (handle == NULL)                                                             /* check handle */
+    uint8_t retry;
+    uint8_t trigger;
+    uint16_t prev;
+    uint16_t check[2];
+    
+    if (handle == NULL)                                                                           /* check handle */
     {
-        return 2;                                                                   /* return error */
+        return 2;                                                                                 /* return error */
     }
-    if (handle->inited != 1)                                                        /* check handle initialization */
+    if (handle->inited != 1)                                                                      /* check handle initialization */
     {
-        return 3;                                                                   /* return error */
+        return 3;                                                                                 /* return error */
     }
     
-    res = a_ina226_iic_write(handle, INA226_REG_ALERT_LIMIT, reg);                  /* write config */
-    if (res != 0)                                                                   /* check result */
+    res = a_ina226_iic_read(handle, INA226_REG_MASK, (uint16_t *)&prev);                          /* read mask */
+    if (res != 0)                                                                                 /* check result */
     {
-        handle->debug_print("ina226: write alert limit register failed.\n");        /* write alert limit register failed */
+        handle->debug_print("ina226: read mask register failed.\n");                              /* read mask register failed */
        
-        return 1;                                                                   /* return error */
+        return 1;                                                                                 /* return error */
+    }
+    if ((prev & (1 << 2)) != 0)                                                                   /* check math overflow */
+    {
+        handle->debug_print("ina226: math overflow.\n");                                          /* math overflow */
+       
+        return 4;                                                                                 /* return error */
+    }
+    trigger = handle->trigger;                                                                    /* save trigger flag */
+    if (trigger != 0)                                                                             /* trigger mode */
+    {
+        res = a_ina226_wait_conversion_ready(handle, (uint16_t *)&prev);                          /* wait conversion ready */
+        if (res != 0)                                                                             /* check result */
+        {
+            return res;                                                                           /* return error */
+        }
+        handle->trigger = 0;                                                                      /* set 0 */
     }
     
-    return 0;                                                                       /* success return 0 */
+    for (retry = 0; retry < INA226_READ_ALL_RETRY; retry++)                                       /* loop all retries */
+    {
+        res = a_ina226_read_sample(handle, sample, (trigger != 0) ? NULL : check);                /* read sample and check */
+        if (res != 0)                                                                             /* check result */
+        {
+            return 1;                                                                             /* return error */
+        }
+        if (trigger != 0)                                                                         /* single shot can't be updated */
+        {
+            break;                                                                                /* break */
+        }
+        if (((int16_t)check[0] == sample->shunt_voltage_raw) && 
+            ((int16_t)check[1] == sample->current_raw))                                           /* check the data unchanged */
+        {
+            break;                                                                                /* break */
+        }
+#if (INA226_ENABLE_STATS != 0)
+        handle->stats.retry++;                                                                    /* retry++ */
+#endif
+    }
+    if (retry == INA226_READ_ALL_RETRY)                                                           /* check retry */
+    {
+        sample->mixed = 1;                                                                        /* may mix two conversions */
+#if (INA226_ENABLE_STATS != 0)
+        handle->stats.mixed++;                                                                    /* mixed++ */
+#endif
+    }
+    
+    return 0;                                                                                     /* success return 0 */
 }
 
 /**
- * @brief      get alert limit
- * @param[in]  *handle pointer to an ina226 handle structure
- * @param[out] *reg pointer to a register buffer
- * @return     status code
- *             - 0 success
- *             - 1 get alert limit failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief         convert the raw data of a sample to float
+ * @param[in]     *handle pointer to an ina226 handle structure
+ * @param[in,out] *sample pointer to a sample structure
+ * @return        status code
+ *                - 0 success
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ * @note          the sample functions only fill the raw and the integer fields,
+ *                call this once a sample is consumed in float
  */
-uint8_t ina226_get_alert_limit(ina226_handle_t *handle, uint16_t *reg)
+uint8_t ina226_sample_convert_to_data(ina226_handle_t *handle, ina226_sample_t *sample)
 {
-    uint8_t res;
-   
     if (handle == NULL)                                                            /* check handle */
     {
         return 2;                                                                  /* return error */
@@ -1450,194 +2143,279 @@ uint8_t ina226_get_alert_limit(ina226_handle_t *handle, uint16_t *reg)
         return 3;                                                                  /* return error */
     }
     
-    res = a_ina226_iic_read(handle, INA226_REG_ALERT_LIMIT, reg);                  /* read config */
-    if (res != 0)                                                                  /* check result */
-    {
-        handle->debug_print("ina226: read alert limit register failed.\n");        /* read alert limit register failed */
-       
-        return 1;                                                                  /* return error */
-    }
+    sample->shunt_voltage_mV = (float)(sample->shunt_voltage_raw) / 400.0f;        /* convert shunt voltage */
+    sample->bus_voltage_mV = (float)(sample->bus_voltage_raw) * 1.25f;             /* convert bus voltage */
+    sample->current_mA = (float)((double)(sample->current_raw) * 
+                                 handle->current_lsb * 1000);                      /* convert current */
+    sample->power_mW = (float)((double)(sample->power_raw) * 
+                               handle->current_lsb * 25.0 * 1000.0);               /* convert power */
     
     return 0;                                                                      /* success return 0 */
 }
 
 /**
- * @brief      convert the shunt voltage to the register raw data
- * @param[in]  *handle pointer to an ina226 handle structure
- * @param[in]  mV millivolt
- * @param[out] *reg pointer to a register raw buffer
- * @return     status code
- *             - 0 success
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief     start a triggered conversion
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 start conversion failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the configured triggered mode is kept, other modes start a shunt and bus conversion
  */
-uint8_t ina226_shunt_voltage_convert_to_register(ina226_handle_t *handle, float mV, uint16_t *reg)
+uint8_t ina226_start_conversion(ina226_handle_t *handle)
 {
-    if (handle == NULL)                  /* check handle */
+    uint8_t res;
+    uint16_t prev;
+    
+    if (handle == NULL)                                                            /* check handle */
     {
-        return 2;                        /* return error */
+        return 2;                                                                  /* return error */
     }
-    if (handle->inited != 1)             /* check handle initialization */
+    if (handle->inited != 1)                                                       /* check handle initialization */
     {
-        return 3;                        /* return error */
+        return 3;                                                                  /* return error */
     }
     
-    *reg = (uint16_t)(mV * 400.0f);      /* convert real data to register data */
+    res = a_ina226_shadow_read(handle, INA226_REG_CONF, (uint16_t *)&prev);        /* read config */
+    if (res != 0)                                                                  /* check result */
+    {
+        handle->debug_print("ina226: read conf register failed.\n");               /* read conf register failed */
+       
+        return 1;                                                                  /* return error */
+    }
+    if (((prev & 0x7) < INA226_MODE_SHUNT_VOLTAGE_TRIGGERED) ||
+        ((prev & 0x7) > INA226_MODE_SHUNT_BUS_VOLTAGE_TRIGGERED))                  /* check triggered mode */
+    {
+        prev &= ~(0x7 << 0);                                                       /* clear mode bit */
+        prev |= INA226_MODE_SHUNT_BUS_VOLTAGE_TRIGGERED << 0;                      /* set mode bit */
+    }
+    res = a_ina226_iic_write(handle, INA226_REG_CONF, (uint16_t )prev);            /* write config */
+    if (res != 0)                                                                  /* check result */
+    {
+        handle->debug_print("ina226: write conf register failed.\n");              /* write conf register failed */
+       
+        return 1;                                                                  /* return error */
+    }
+    handle->trigger = 1;                                                           /* set 1 */
+    handle->finished = 0;                                                          /* not finished */
     
-    return 0;                            /* success return 0 */
+    return 0;                                                                      /* success return 0 */
 }
 
 /**
- * @brief      convert the register raw data to the shunt voltage
+ * @brief      poll the triggered conversion
  * @param[in]  *handle pointer to an ina226 handle structure
- * @param[in]  reg register raw data
- * @param[out] *mV pointer to a millivolt buffer
+ * @param[out] *ready pointer to a bool value buffer
  * @return     status code
  *             - 0 success
+ *             - 1 poll conversion failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- * @note       none
+ *             - 4 math overflow
+ *             - 5 no conversion is started
+ * @note       one mask read without any delay
  */
-uint8_t ina226_shunt_voltage_convert_to_data(ina226_handle_t *handle, uint16_t reg, float *mV)
+uint8_t ina226_poll_conversion(ina226_handle_t *handle, ina226_bool_t *ready)
 {
-    if (handle == NULL)               /* check handle */
+    uint8_t res;
+    uint16_t prev;
+    
+    if (handle == NULL)                                                         /* check handle */
     {
-        return 2;                     /* return error */
+        return 2;                                                               /* return error */
     }
-    if (handle->inited != 1)          /* check handle initialization */
+    if (handle->inited != 1)                                                    /* check handle initialization */
     {
-        return 3;                     /* return error */
+        return 3;                                                               /* return error */
     }
     
-    *mV = (float)(reg) / 400.0f;      /* convert real data to register data */
+    if (handle->trigger == 0)                                                   /* check the conversion */
+    {
+        if (handle->finished == 0)                                              /* check the started conversion */
+        {
+            handle->debug_print("ina226: no conversion is started.\n");         /* no conversion is started */
+            
+            return 5;                                                           /* return error */
+        }
+        *ready = INA226_BOOL_TRUE;                                              /* finished and not fetched */
+        
+        return 0;                                                               /* success return 0 */
+    }
+    res = a_ina226_iic_read(handle, INA226_REG_MASK, (uint16_t *)&prev);        /* read mask */
+    if (res != 0)                                                               /* check result */
+    {
+        handle->debug_print("ina226: read mask register failed.\n");            /* read mask register failed */
+       
+        return 1;                                                               /* return error */
+    }
+    if ((prev & (1 << 2)) != 0)                                                 /* check math overflow */
+    {
+        handle->debug_print("ina226: math overflow.\n");                        /* math overflow */
+       
+        return 4;                                                               /* return error */
+    }
+    if ((prev & (1 << 3)) != 0)                                                 /* check conversion ready flag */
+    {
+        handle->trigger = 0;                                                    /* set 0 */
+        handle->finished = 1;                                                   /* finished */
+        *ready = INA226_BOOL_TRUE;                                              /* ready */
+    }
+    else
+    {
+        *ready = INA226_BOOL_FALSE;                                             /* busy */
+    }
     
-    return 0;                         /* success return 0 */
+    return 0;                                                                   /* success return 0 */
 }
 
 /**
- * @brief      convert the bus voltage to the register raw data
+ * @brief      fetch the sample of a finished conversion
  * @param[in]  *handle pointer to an ina226 handle structure
- * @param[in]  mV millivolt
- * @param[out] *reg pointer to a register raw buffer
+ * @param[out] *sample pointer to a sample structure
  * @return     status code
  *             - 0 success
+ *             - 1 fetch sample failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- * @note       none
+ *             - 4 conversion is not ready
+ *             - 5 no conversion is started
+ * @note       ina226_poll_conversion must report ready first,
+ *             every started conversion can be fetched once
  */
-uint8_t ina226_bus_voltage_convert_to_register(ina226_handle_t *handle, float mV, uint16_t *reg)
+uint8_t ina226_fetch_sample(ina226_handle_t *handle, ina226_sample_t *sample)
 {
-    if (handle == NULL)                   /* check handle */
+    uint8_t res;
+    
+    if (handle == NULL)                                                   /* check handle */
     {
-        return 2;                         /* return error */
+        return 2;                                                         /* return error */
     }
-    if (handle->inited != 1)              /* check handle initialization */
+    if (handle->inited != 1)                                              /* check handle initialization */
     {
-        return 3;                         /* return error */
+        return 3;                                                         /* return error */
+    }
+    if (handle->trigger != 0)                                             /* check the conversion */
+    {
+        handle->debug_print("ina226: conversion is not ready.\n");        /* conversion is not ready */
+        
+        return 4;                                                         /* return error */
+    }
+    if (handle->finished == 0)                                            /* check the started conversion */
+    {
+        handle->debug_print("ina226: no conversion is started.\n");       /* no conversion is started */
+        
+        return 5;                                                         /* return error */
     }
     
-    *reg = (uint16_t)(mV / 1.25f);        /* convert real data to register data */
+    res = a_ina226_read_sample(handle, sample, NULL);                     /* read sample */
+    if (res != 0)                                                         /* check result */
+    {
+        return 1;                                                         /* return error */
+    }
+    handle->finished = 0;                                                 /* fetched */
     
-    return 0;                             /* success return 0 */
+    return 0;                                                             /* success return 0 */
 }
 
 /**
- * @brief      convert the register raw data to the bus voltage
+ * @brief      get the calibration
  * @param[in]  *handle pointer to an ina226 handle structure
- * @param[in]  reg register raw data
- * @param[out] *mV pointer to a millivolt buffer
+ * @param[out] *data pointer to a calibration data buffer
  * @return     status code
  *             - 0 success
+ *             - 1 get calibration failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t ina226_bus_voltage_convert_to_data(ina226_handle_t *handle, uint16_t reg, float *mV)
+uint8_t ina226_get_calibration(ina226_handle_t *handle, uint16_t *data)
 {
-    if (handle == NULL)                /* check handle */
+    uint8_t res;
+   
+    if (handle == NULL)                                                              /* check handle */
     {
-        return 2;                      /* return error */
+        return 2;                                                                    /* return error */
     }
-    if (handle->inited != 1)           /* check handle initialization */
+    if (handle->inited != 1)                                                         /* check handle initialization */
     {
-        return 3;                      /* return error */
+        return 3;                                                                    /* return error */
     }
     
-    *mV = (float)(reg) * 1.25f;        /* convert real data to register data */
+    res = a_ina226_shadow_read(handle, INA226_REG_CALIBRATION, (uint16_t *)data);    /* read calibration */
+    if (res != 0)                                                                    /* check result */
+    {
+        handle->debug_print("ina226: read calibration register failed.\n");          /* read calibration register failed */
+       
+        return 1;                                                                    /* return error */
+    }
     
-    return 0;                          /* success return 0 */
+    return 0;                                                                        /* success return 0 */
 }
 
 /**
- * @brief      convert the power to the register raw data
+ * @brief      calculate the calibration
  * @param[in]  *handle pointer to an ina226 handle structure
- * @param[in]  mW milliwatt
- * @param[out] *reg pointer to a register raw buffer
+ * @param[out] *calibration pointer to a calibration data buffer
  * @return     status code
  *             - 0 success
+ *             - 1 calculate calibration failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
+ *             - 4 r can't be zero
  * @note       none
  */
-uint8_t ina226_power_convert_to_register(ina226_handle_t *handle, float mW, uint16_t *reg)
+uint8_t ina226_calculate_calibration(ina226_handle_t *handle, uint16_t *calibration)
 {
-    if (handle == NULL)                                                             /* check handle */
+    double v;
+   
+    if (handle == NULL)                                                /* check handle */
     {
-        return 2;                                                                   /* return error */
+        return 2;                                                      /* return error */
     }
-    if (handle->inited != 1)                                                        /* check handle initialization */
+    if (handle->inited != 1)                                           /* check handle initialization */
     {
-        return 3;                                                                   /* return error */
+        return 3;                                                      /* return error */
+    }
+    if ((handle->r >= -0.000001f)  && (handle->r <= 0.000001f))        /* check the r */
+    {
+        handle->debug_print("ina226: r can't be zero.\n");             /* r can't be zero */
+       
+        return 4;                                                      /* return error */
     }
     
-    *reg = (uint16_t)((double)(mW) / (handle->current_lsb * 25.0 * 1000.0));        /* set the converted data */
+    v = 0.08192 / 32768.0;                                             /* max range / 2^15 */
+    handle->current_lsb = v / handle->r;                               /* current lsb */
+    *calibration = (uint16_t)(0.00512 / v + 0.5);                      /* set calibration */
+    v = handle->current_lsb * 1e9 + 0.5;                               /* round the current lsb in nA */
+    handle->current_lsb_na = (uint32_t)v;                              /* current lsb in nA */
     
-    return 0;                                                                       /* success return 0 */
+    return 0;                                                          /* success return 0 */
 }
 
 /**
- * @brief      convert the register raw data to the power
+ * @brief      calculate the calibration from the max expected current
  * @param[in]  *handle pointer to an ina226 handle structure
- * @param[in]  reg register raw data
- * @param[out] *mW pointer to a milliwatt buffer
+ * @param[in]  max_current_mA max expected current in mA
+ * @param[in]  round_lsb bool value
+ * @param[out] *calibration pointer to a calibration data buffer
+ * @param[out] *lsb_mA pointer to an effective current lsb buffer
+ * @param[out] *headroom_mA pointer to an overflow headroom buffer
  * @return     status code
  *             - 0 success
+ *             - 1 calculate calibration ex failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- * @note       none
+ *             - 4 r can't be zero
+ *             - 5 max current is invalid
+ * @note       round_lsb rounds the current lsb up to a 1, 2 or 5 decimal step
  */
-uint8_t ina226_power_convert_to_data(ina226_handle_t *handle, uint16_t reg, float *mW)
+uint8_t ina226_calculate_calibration_ex(ina226_handle_t *handle, float max_current_mA, ina226_bool_t round_lsb,
+                                        uint16_t *calibration, float *lsb_mA, float *headroom_mA)
 {
-    if (handle == NULL)                                                        /* check handle */
-    {
-        return 2;                                                              /* return error */
-    }
-    if (handle->inited != 1)                                                   /* check handle initialization */
-    {
-        return 3;                                                              /* return error */
-    }
-    
-    *mW = (float)((double)(reg) * handle->current_lsb * 25.0 * 1000.0);        /* set the converted data */
+    double lsb;
+    double cal;
     
-    return 0;                                                                  /* success return 0 */
-}
-
-/**
- * @brief     irq handler
- * @param[in] *handle pointer to an ina226 handle structure
- * @return    status code
- *            - 0 success
- *            - 1 run failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
- */
-uint8_t ina226_irq_handler(ina226_handle_t *handle)
-{
-    uint8_t res;
-    uint16_t prev;
-   
     if (handle == NULL)                                                                     /* check handle */
     {
         return 2;                                                                           /* return error */
@@ -1646,283 +2424,2699 @@ uint8_t ina226_irq_handler(ina226_handle_t *handle)
     {
         return 3;                                                                           /* return error */
     }
-    
-    res = a_ina226_iic_read(handle, INA226_REG_MASK, (uint16_t *)&prev);                    /* read mask */
-    if (res != 0)                                                                           /* check result */
+    if ((handle->r >= -0.000001f)  && (handle->r <= 0.000001f))                             /* check the r */
     {
-        handle->debug_print("ina226: read mask register failed.\n");                        /* read mask register failed */
+        handle->debug_print("ina226: r can't be zero.\n");                                  /* r can't be zero */
        
-        return 1;                                                                           /* return error */
+        return 4;                                                                           /* return error */
     }
-    if ((prev & (1 << 4)) != 0)                                                             /* check alert flag */
+    if ((max_current_mA <= 0.0f) || 
+        ((double)max_current_mA / 1000.0 * handle->r > 0.08192))                            /* check the max current */
     {
-        if ((prev & (1 << 15)) != 0)                                                        /* shunt voltage over voltage */
+        handle->debug_print("ina226: max current is invalid.\n");                           /* max current is invalid */
+       
+        return 5;                                                                           /* return error */
+    }
+    
+    lsb = (double)max_current_mA / 1000.0 / 32768.0;                                        /* min current lsb */
+    if (round_lsb == INA226_BOOL_TRUE)                                                      /* round the lsb */
+    {
+        double step;
+        
+        step = 1.0;                                                                         /* init 1.0 */
+        while (step > lsb)                                                                  /* find the decade */
         {
-            if (handle->receive_callback != NULL)                                           /* check not null */
-            {
-                handle->receive_callback(INA226_STATUS_SHUNT_VOLTAGE_OVER_VOLTAGE);         /* run callback */
-            }
+            step /= 10.0;                                                                   /* step / 10 */
         }
-        else if ((prev & (1 << 14)) != 0)                                                   /* shunt voltage under voltage */
+        while (step * 10.0 <= lsb)                                                          /* find the decade */
         {
-            if (handle->receive_callback != NULL)                                           /* check not null */
-            {
-                handle->receive_callback(INA226_STATUS_SHUNT_VOLTAGE_UNDER_VOLTAGE);        /* run callback */
-            }
+            step *= 10.0;                                                                   /* step * 10 */
         }
-        else if ((prev & (1 << 13)) != 0)                                                   /* bus voltage over voltage */
+        if (lsb <= step)                                                                    /* 1 step */
         {
-            if (handle->receive_callback != NULL)                                           /* check not null */
-            {
-                handle->receive_callback(INA226_STATUS_BUS_VOLTAGE_OVER_VOLTAGE);           /* run callback */
-            }
+            lsb = step;                                                                     /* set 1 */
         }
-        else if ((prev & (1 << 12)) != 0)                                                   /* bus voltage under voltage */
+        else if (lsb <= step * 2.0)                                                         /* 2 step */
         {
-            if (handle->receive_callback != NULL)                                           /* check not null */
-            {
-                handle->receive_callback(INA226_STATUS_BUS_VOLTAGE_UNDER_VOLTAGE);          /* run callback */
-            }
+            lsb = step * 2.0;                                                               /* set 2 */
         }
-        else if ((prev & (1 << 11)) != 0)                                                   /* power over limit */
+        else if (lsb <= step * 5.0)                                                         /* 5 step */
         {
-            if (handle->receive_callback != NULL)                                           /* check not null */
-            {
-                handle->receive_callback(INA226_STATUS_POWER_OVER_LIMIT);                   /* run callback */
-            }
+            lsb = step * 5.0;                                                               /* set 5 */
         }
         else
         {
-                                                                                            /* do nothing */
+            lsb = step * 10.0;                                                              /* set 10 */
         }
     }
+    cal = 0.00512 / (lsb * handle->r);                                                      /* calculate calibration */
+    if (cal > 32767.0)                                                                      /* check the max calibration */
+    {
+        cal = 32767.0;                                                                      /* limit by the shunt range */
+    }
+    if (cal < 1.0)                                                                          /* check the min calibration */
+    {
+        handle->debug_print("ina226: max current is invalid.\n");                           /* max current is invalid */
+       
+        return 5;                                                                           /* return error */
+    }
+    *calibration = (uint16_t)cal;                                                           /* round down to avoid overflow */
+    handle->current_lsb = 0.00512 / ((double)(*calibration) * handle->r);                   /* effective current lsb */
+    handle->current_lsb_na = (uint32_t)(handle->current_lsb * 1e9 + 0.5);                   /* current lsb in nA */
+    *lsb_mA = (float)(handle->current_lsb * 1000.0);                                        /* set the lsb */
+    *headroom_mA = (float)(handle->current_lsb * 32767.0 * 1000.0) - max_current_mA;        /* set the headroom */
     
     return 0;                                                                               /* success return 0 */
 }
 
 /**
- * @brief     initialize the chip
+ * @brief     set the calibration
  * @param[in] *handle pointer to an ina226 handle structure
+ * @param[in] data calibration data
  * @return    status code
  *            - 0 success
- *            - 1 iic initialization failed
+ *            - 1 set calibration failed
  *            - 2 handle is NULL
- *            - 3 linked functions is NULL
- *            - 4 id is invalid
- *            - 5 soft reset failed
+ *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t ina226_init(ina226_handle_t *handle)
+uint8_t ina226_set_calibration(ina226_handle_t *handle, uint16_t data)
 {
     uint8_t res;
-    uint16_t prev;
-    
-    if (handle == NULL)                                                                /* check handle */
+   
+    if (handle == NULL)                                                             /* check handle */
     {
-        return 2;                                                                      /* return error */
+        return 2;                                                                   /* return error */
     }
-    if (handle->debug_print == NULL)                                                   /* check debug_print */
+    if (handle->inited != 1)                                                        /* check handle initialization */
     {
-        return 3;                                                                      /* return error */
+        return 3;                                                                   /* return error */
     }
-    if (handle->iic_init == NULL)                                                      /* check iic_init */
+    
+    res = a_ina226_iic_write(handle, INA226_REG_CALIBRATION, data);                 /* write calibration */
+    if (res != 0)                                                                   /* check result */
     {
-        handle->debug_print("ina226: iic_init is null.\n");                            /* iic_init is null */
-        
-        return 3;                                                                      /* return error */
-    }
-    if (handle->iic_deinit == NULL)                                                    /* check iic_deinit */
-    {
-        handle->debug_print("ina226: iic_deinit is null.\n");                          /* iic_deinit is null */
-        
-        return 3;                                                                      /* return error */
-    }
-    if (handle->iic_read == NULL)                                                      /* check iic_read */
-    {
-        handle->debug_print("ina226: iic_read is null.\n");                            /* iic_read is null */
-        
-        return 3;                                                                      /* return error */
-    }
-    if (handle->iic_write == NULL)                                                     /* check iic_write */
-    {
-        handle->debug_print("ina226: iic_write is null.\n");                           /* iic_write is null */
-        
-        return 3;                                                                      /* return error */
-    }
-    if (handle->delay_ms == NULL)                                                      /* check delay_ms */
-    {
-        handle->debug_print("ina226: delay_ms is null.\n");                            /* delay_ms is null */
-        
-        return 3;                                                                      /* return error */
-    }
-    if (handle->receive_callback == NULL)                                              /* check receive_callback */
-    {
-        handle->debug_print("ina226: receive_callback is null.\n");                    /* receive_callback is null */
-        
-        return 3;                                                                      /* return error */
+        handle->debug_print("ina226: write calibration register failed.\n");        /* write calibration register failed */
+       
+        return 1;                                                                   /* return error */
     }
     
-    if (handle->iic_init() != 0)                                                       /* iic init */
+    return 0;                                                                       /* success return 0 */
+}
+
+/**
+ * @brief     enable or disable mask
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @param[in] mask set mask
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set mask failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ina226_set_mask(ina226_handle_t *handle, ina226_mask_t mask, ina226_bool_t enable)
+{
+    uint8_t res;
+    uint16_t prev;
+   
+    if (handle == NULL)                                                         /* check handle */
     {
-        handle->debug_print("ina226: iic init failed.\n");                             /* iic init failed */
-        
-        return 1;                                                                      /* return error */
+        return 2;                                                               /* return error */
     }
-    res = a_ina226_iic_read(handle, INA226_REG_MANUFACTURER, (uint16_t *)&prev);       /* read manufacturer */
-    if (res != 0)                                                                      /* check result */
+    if (handle->inited != 1)                                                    /* check handle initialization */
     {
-        handle->debug_print("ina226: read manufacturer failed.\n");                    /* read manufacturer failed */
-        (void)handle->iic_deinit();                                                    /* iic deinit */
-       
-        return 4;                                                                      /* return error */
+        return 3;                                                               /* return error */
     }
-    if (prev != 0x5449)                                                                /* check id */
+    
+    res = a_ina226_shadow_read(handle, INA226_REG_MASK, (uint16_t *)&prev);     /* read mask */
+    if (res != 0)                                                               /* check result */
     {
-        handle->debug_print("ina226: id is invalid.\n");                               /* id is invalid */
-        (void)handle->iic_deinit();                                                    /* iic deinit */
+        handle->debug_print("ina226: read mask register failed.\n");            /* read mask register failed */
        
-        return 4;                                                                      /* return error */
+        return 1;                                                               /* return error */
     }
-    res = a_ina226_iic_read(handle, INA226_REG_CONF, (uint16_t *)&prev);               /* read conf */
-    if (res != 0)                                                                      /* check result */
+    prev &= ~(1 << mask);                                                       /* clear settings */
+    prev |= (enable << mask);                                                   /* set mask */
+    res = a_ina226_iic_write(handle, INA226_REG_MASK, prev);                    /* write mask */
+    if (res != 0)                                                               /* check result */
     {
-        handle->debug_print("ina226: read conf register failed.\n");                   /* read conf register failed */
-        (void)handle->iic_deinit();                                                    /* iic deinit */
+        handle->debug_print("ina226: write mask register failed.\n");           /* write mask register failed */
        
-        return 5;                                                                      /* return error */
+        return 1;                                                               /* return error */
     }
-    prev |= 1 << 15;                                                                   /* set bit */
-    res = a_ina226_iic_write(handle, INA226_REG_CONF, prev);                           /* write conf */
-    if (res != 0)                                                                      /* check result */
+    
+    return 0;                                                                   /* success return 0 */
+}
+
+/**
+ * @brief      get mask
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[in]  mask set mask
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get mask failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ina226_get_mask(ina226_handle_t *handle, ina226_mask_t mask, ina226_bool_t *enable)
+{
+    uint8_t res;
+    uint16_t prev;
+   
+    if (handle == NULL)                                                         /* check handle */
     {
-        handle->debug_print("ina226: write conf register failed.\n");                  /* write conf register failed */
-        (void)handle->iic_deinit();                                                    /* iic deinit */
-        
-        return 5;                                                                      /* return error */
+        return 2;                                                               /* return error */
     }
-    handle->delay_ms(10);                                                              /* delay 10 ms */
-    res = a_ina226_iic_read(handle, INA226_REG_CONF, (uint16_t *)&prev);               /* read conf */
-    if (res != 0)                                                                      /* check result */
+    if (handle->inited != 1)                                                    /* check handle initialization */
     {
-        handle->debug_print("ina226: read conf register failed.\n");                   /* read conf register failed */
-        (void)handle->iic_deinit();                                                    /* iic deinit */
-        
-        return 5;                                                                      /* return error */
+        return 3;                                                               /* return error */
     }
-    if ((prev & (1 << 15)) != 0)                                                       /* check the result */
+    
+    res = a_ina226_shadow_read(handle, INA226_REG_MASK, (uint16_t *)&prev);     /* read mask */
+    if (res != 0)                                                               /* check result */
     {
-        handle->debug_print("ina226: soft reset failed.\n");                           /* soft reset failed */
-        (void)handle->iic_deinit();                                                    /* iic deinit */
-        
-        return 5;                                                                      /* return error */
+        handle->debug_print("ina226: read mask register failed.\n");            /* read mask register failed */
+       
+        return 1;                                                               /* return error */
     }
-    handle->trigger = 0;                                                               /* none */
-    handle->inited = 1;                                                                /* flag inited */
+    *enable = (ina226_bool_t)((prev >> mask) & 0x01);                           /* get bool */
     
-    return 0;                                                                          /* success return 0 */
+    return 0;                                                                   /* success return 0 */
 }
 
 /**
- * @brief     close the chip
+ * @brief     enable or disable conversion ready alert pin
  * @param[in] *handle pointer to an ina226 handle structure
+ * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 iic deinit failed
+ *            - 1 set conversion ready alert pin failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 power down failed
  * @note      none
  */
-uint8_t ina226_deinit(ina226_handle_t *handle)
+uint8_t ina226_set_conversion_ready_alert_pin(ina226_handle_t *handle, ina226_bool_t enable)
 {
     uint8_t res;
     uint16_t prev;
    
-    if (handle == NULL)                                                        /* check handle */
+    if (handle == NULL)                                                         /* check handle */
     {
-        return 2;                                                              /* return error */
+        return 2;                                                               /* return error */
     }
-    if (handle->inited != 1)                                                   /* check handle initialization */
+    if (handle->inited != 1)                                                    /* check handle initialization */
     {
-        return 3;                                                              /* return error */
+        return 3;                                                               /* return error */
     }
     
-    res = a_ina226_iic_read(handle, INA226_REG_CONF, (uint16_t *)&prev);       /* read config */
-    if (res != 0)                                                              /* check result */
+    res = a_ina226_shadow_read(handle, INA226_REG_MASK, (uint16_t *)&prev);     /* read mask */
+    if (res != 0)                                                               /* check result */
     {
-        handle->debug_print("ina226: read conf register failed.\n");           /* read conf register failed */
+        handle->debug_print("ina226: read mask register failed.\n");            /* read mask register failed */
        
-        return 4;                                                              /* return error */
+        return 1;                                                               /* return error */
     }
-    prev &= ~(0x07);                                                           /* clear mode */
-    res = a_ina226_iic_write(handle, INA226_REG_CONF, (uint16_t )prev);        /* write config */
-    if (res != 0)                                                              /* check result */
+    prev &= ~(1 << 10);                                                         /* clear settings */
+    prev |= (enable << 10);                                                     /* set mask */
+    res = a_ina226_iic_write(handle, INA226_REG_MASK, prev);                    /* write mask */
+    if (res != 0)                                                               /* check result */
     {
-        handle->debug_print("ina226: write conf register failed.\n");          /* write conf register failed */
+        handle->debug_print("ina226: write mask register failed.\n");           /* write mask register failed */
        
-        return 4;                                                              /* return error */
+        return 1;                                                               /* return error */
     }
-    res = handle->iic_deinit();                                                /* iic deinit */
-    if (res != 0)                                                              /* check result */
+    
+    return 0;                                                                   /* success return 0 */
+}
+
+/**
+ * @brief      get conversion ready alert pin status
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get conversion ready alert pin failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ina226_get_conversion_ready_alert_pin(ina226_handle_t *handle, ina226_bool_t *enable)
+{
+    uint8_t res;
+    uint16_t prev;
+   
+    if (handle == NULL)                                                         /* check handle */
     {
-        handle->debug_print("ina226: iic deinit failed.\n");                   /* iic deinit failed */
+        return 2;                                                               /* return error */
+    }
+    if (handle->inited != 1)                                                    /* check handle initialization */
+    {
+        return 3;                                                               /* return error */
+    }
+    
+    res = a_ina226_shadow_read(handle, INA226_REG_MASK, (uint16_t *)&prev);     /* read mask */
+    if (res != 0)                                                               /* check result */
+    {
+        handle->debug_print("ina226: read mask register failed.\n");            /* read mask register failed */
        
-        return 1;                                                              /* return error */
+        return 1;                                                               /* return error */
     }
+    *enable = (ina226_bool_t)((prev >> 10) & 0x01);                             /* get bool */
     
-    return 0;                                                                  /* success return 0 */
+    return 0;                                                                   /* success return 0 */
 }
 
 /**
- * @brief     set the chip register
+ * @brief     set alert polarity pin
  * @param[in] *handle pointer to an ina226 handle structure
- * @param[in] reg register address
- * @param[in] data written data
+ * @param[in] pin alert polarity pin
  * @return    status code
  *            - 0 success
- *            - 1 write failed
+ *            - 1 set alert polarity pin failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t ina226_set_reg(ina226_handle_t *handle, uint8_t reg, uint16_t data)
+uint8_t ina226_set_alert_polarity_pin(ina226_handle_t *handle, ina226_alert_polarity_t pin)
 {
-    if (handle == NULL)                                 /* check handle */
+    uint8_t res;
+    uint16_t prev;
+   
+    if (handle == NULL)                                                         /* check handle */
     {
-        return 2;                                       /* return error */
+        return 2;                                                               /* return error */
     }
-    if (handle->inited != 1)                            /* check handle initialization */
+    if (handle->inited != 1)                                                    /* check handle initialization */
     {
-        return 3;                                       /* return error */
+        return 3;                                                               /* return error */
     }
     
-    return a_ina226_iic_write(handle, reg, data);       /* write data */
+    res = a_ina226_shadow_read(handle, INA226_REG_MASK, (uint16_t *)&prev);     /* read mask */
+    if (res != 0)                                                               /* check result */
+    {
+        handle->debug_print("ina226: read mask register failed.\n");            /* read mask register failed */
+       
+        return 1;                                                               /* return error */
+    }
+    prev &= ~(1 << 1);                                                          /* clear settings */
+    prev |= (pin << 1);                                                         /* set mask */
+    res = a_ina226_iic_write(handle, INA226_REG_MASK, prev);                    /* write mask */
+    if (res != 0)                                                               /* check result */
+    {
+        handle->debug_print("ina226: write mask register failed.\n");           /* write mask register failed */
+       
+        return 1;                                                               /* return error */
+    }
+    
+    return 0;                                                                   /* success return 0 */
 }
 
 /**
- * @brief      get the chip register
+ * @brief      get alert polarity pin
  * @param[in]  *handle pointer to an ina226 handle structure
- * @param[in]  reg register address
- * @param[out] *data pointer to a data buffer
+ * @param[out] *pin pointer to an alert polarity pin buffer
  * @return     status code
  *             - 0 success
- *             - 1 read failed
+ *             - 1 get alert polarity pin failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t ina226_get_reg(ina226_handle_t *handle, uint8_t reg, uint16_t *data)
+uint8_t ina226_get_alert_polarity_pin(ina226_handle_t *handle, ina226_alert_polarity_t *pin)
 {
-    if (handle == NULL)                                /* check handle */
-    {
-        return 2;                                      /* return error */
+    uint8_t res;
+    uint16_t prev;
+   
+    if (handle == NULL)                                                         /* check handle */
+    {
+        return 2;                                                               /* return error */
+    }
+    if (handle->inited != 1)                                                    /* check handle initialization */
+    {
+        return 3;                                                               /* return error */
+    }
+    
+    res = a_ina226_shadow_read(handle, INA226_REG_MASK, (uint16_t *)&prev);     /* read mask */
+    if (res != 0)                                                               /* check result */
+    {
+        handle->debug_print("ina226: read mask register failed.\n");            /* read mask register failed */
+       
+        return 1;                                                               /* return error */
+    }
+    *pin = (ina226_alert_polarity_t)((prev >> 1) & 0x01);                       /* get alert polarity pin */
+    
+    return 0;                                                                   /* success return 0 */
+}
+
+/**
+ * @brief     enable or disable alert latch
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set alert latch failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ina226_set_alert_latch(ina226_handle_t *handle, ina226_bool_t enable)
+{
+    uint8_t res;
+    uint16_t prev;
+   
+    if (handle == NULL)                                                         /* check handle */
+    {
+        return 2;                                                               /* return error */
+    }
+    if (handle->inited != 1)                                                    /* check handle initialization */
+    {
+        return 3;                                                               /* return error */
+    }
+    
+    res = a_ina226_shadow_read(handle, INA226_REG_MASK, (uint16_t *)&prev);     /* read mask */
+    if (res != 0)                                                               /* check result */
+    {
+        handle->debug_print("ina226: read mask register failed.\n");            /* read mask register failed */
+       
+        return 1;                                                               /* return error */
+    }
+    prev &= ~(1 << 0);                                                          /* clear settings */
+    prev |= (enable << 0);                                                      /* set mask */
+    res = a_ina226_iic_write(handle, INA226_REG_MASK, prev);                    /* write mask */
+    if (res != 0)                                                               /* check result */
+    {
+        handle->debug_print("ina226: write mask register failed.\n");           /* write mask register failed */
+       
+        return 1;                                                               /* return error */
+    }
+    
+    return 0;                                                                   /* success return 0 */
+}
+
+/**
+ * @brief      get alert latch status
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get alert latch failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ina226_get_alert_latch(ina226_handle_t *handle, ina226_bool_t *enable)
+{
+    uint8_t res;
+    uint16_t prev;
+   
+    if (handle == NULL)                                                         /* check handle */
+    {
+        return 2;                                                               /* return error */
+    }
+    if (handle->inited != 1)                                                    /* check handle initialization */
+    {
+        return 3;                                                               /* return error */
+    }
+    
+    res = a_ina226_shadow_read(handle, INA226_REG_MASK, (uint16_t *)&prev);     /* read mask */
+    if (res != 0)                                                               /* check result */
+    {
+        handle->debug_print("ina226: read mask register failed.\n");            /* read mask register failed */
+       
+        return 1;                                                               /* return error */
+    }
+    *enable = (ina226_bool_t)((prev >> 0) & 0x01);                              /* get bool */
+    
+    return 0;                                                                   /* success return 0 */
+}
+
+/**
+ * @brief     set alert limit
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @param[in] reg set register
+ * @return    status code
+ *            - 0 success
+ *            - 1 set alert limit failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ina226_set_alert_limit(ina226_handle_t *handle, uint16_t reg)
+{
+    uint8_t res;
+   
+    if (handle == NULL)                                                             /* check handle */
+    {
+        return 2;                                                                   /* return error */
+    }
+    if (handle->inited != 1)                                                        /* check handle initialization */
+    {
+        return 3;                                                                   /* return error */
+    }
+    
+    res = a_ina226_iic_write(handle, INA226_REG_ALERT_LIMIT, reg);                  /* write config */
+    if (res != 0)                                                                   /* check result */
+    {
+        handle->debug_print("ina226: write alert limit register failed.\n");        /* write alert limit register failed */
+       
+        return 1;                                                                   /* return error */
+    }
+    
+    return 0;                                                                       /* success return 0 */
+}
+
+/**
+ * @brief      get alert limit
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[out] *reg pointer to a register buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get alert limit failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ina226_get_alert_limit(ina226_handle_t *handle, uint16_t *reg)
+{
+    uint8_t res;
+   
+    if (handle == NULL)                                                            /* check handle */
+    {
+        return 2;                                                                  /* return error */
+    }
+    if (handle->inited != 1)                                                       /* check handle initialization */
+    {
+        return 3;                                                                  /* return error */
+    }
+    
+    res = a_ina226_shadow_read(handle, INA226_REG_ALERT_LIMIT, reg);               /* read config */
+    if (res != 0)                                                                  /* check result */
+    {
+        handle->debug_print("ina226: read alert limit register failed.\n");        /* read alert limit register failed */
+       
+        return 1;                                                                  /* return error */
+    }
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief     check a value against the register range
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @param[in] channel watched channel
+ * @param[in] value value in mV, mA or mW
+ * @return    status code
+ *            - 0 success
+ *            - 1 threshold is out of range
+ * @note      none
+ */
+static uint8_t a_ina226_alert_threshold_check(ina226_handle_t *handle, ina226_channel_t channel, float value)
+{
+    double raw;
+    double min;
+    double max;
+    
+    if (channel == INA226_CHANNEL_SHUNT_VOLTAGE)                                      /* shunt voltage */
+    {
+        raw = (double)value * 400.0;                                                  /* shunt voltage raw */
+        min = -32768.0;                                                               /* signed 16 bits */
+        max = 32767.0;                                                                /* signed 16 bits */
+    }
+    else if (channel == INA226_CHANNEL_BUS_VOLTAGE)                                   /* bus voltage */
+    {
+        raw = (double)value / 1.25;                                                   /* bus voltage raw */
+        min = 0.0;                                                                    /* unsigned 15 bits */
+        max = 32767.0;                                                                /* unsigned 15 bits */
+    }
+    else                                                                                  /* current and power */
+    {
+        if ((handle->current_lsb >= -1e-12) && (handle->current_lsb <= 1e-12))        /* check the current lsb */
+        {
+            return 1;                                                                 /* return error */
+        }
+        if (channel == INA226_CHANNEL_CURRENT)                                        /* current */
+        {
+            raw = (double)value / (handle->current_lsb * 1000.0);                     /* current raw */
+            min = -32768.0;                                                           /* signed 16 bits */
+            max = 32767.0;                                                            /* signed 16 bits */
+        }
+        else                                                                          /* power */
+        {
+            raw = (double)value / (handle->current_lsb * 25.0 * 1000.0);              /* power raw */
+            min = 0.0;                                                                /* unsigned 16 bits */
+            max = 65535.0;                                                            /* unsigned 16 bits */
+        }
+    }
+    if ((raw < min) || (raw > max))                                                   /* check the range */
+    {
+        return 1;                                                                     /* return error */
+    }
+    
+    return 0;                                                                         /* success return 0 */
+}
+
+/**
+ * @brief      convert the shunt voltage to the register raw data
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[in]  mV millivolt
+ * @param[out] *reg pointer to a register raw buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 mV is out of range
+ * @note       none
+ */
+uint8_t ina226_shunt_voltage_convert_to_register(ina226_handle_t *handle, float mV, uint16_t *reg)
+{
+    if (handle == NULL)                  /* check handle */
+    {
+        return 2;                        /* return error */
+    }
+    if (handle->inited != 1)             /* check handle initialization */
+    {
+        return 3;                        /* return error */
+    }
+    if (a_ina226_alert_threshold_check(handle, INA226_CHANNEL_SHUNT_VOLTAGE, mV) != 0)        /* check the range */
+    {
+        handle->debug_print("ina226: shunt voltage is out of range.\n");                      /* shunt voltage is out of range */
+        
+        return 4;                                                                             /* return error */
+    }
+    
+    *reg = (uint16_t)((int16_t)(mV * 400.0f));        /* convert real data to register data */
+    
+    return 0;                            /* success return 0 */
+}
+
+/**
+ * @brief      convert the register raw data to the shunt voltage
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[in]  reg register raw data
+ * @param[out] *mV pointer to a millivolt buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ina226_shunt_voltage_convert_to_data(ina226_handle_t *handle, uint16_t reg, float *mV)
+{
+    if (handle == NULL)               /* check handle */
+    {
+        return 2;                     /* return error */
+    }
+    if (handle->inited != 1)          /* check handle initialization */
+    {
+        return 3;                     /* return error */
+    }
+    
+    *mV = (float)((int16_t)reg) / 400.0f;        /* convert real data to register data */
+    
+    return 0;                         /* success return 0 */
+}
+
+/**
+ * @brief      convert the bus voltage to the register raw data
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[in]  mV millivolt
+ * @param[out] *reg pointer to a register raw buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 mV is out of range
+ * @note       none
+ */
+uint8_t ina226_bus_voltage_convert_to_register(ina226_handle_t *handle, float mV, uint16_t *reg)
+{
+    if (handle == NULL)                   /* check handle */
+    {
+        return 2;                         /* return error */
+    }
+    if (handle->inited != 1)              /* check handle initialization */
+    {
+        return 3;                         /* return error */
+    }
+    if (a_ina226_alert_threshold_check(handle, INA226_CHANNEL_BUS_VOLTAGE, mV) != 0)        /* check the range */
+    {
+        handle->debug_print("ina226: bus voltage is out of range.\n");                      /* bus voltage is out of range */
+        
+        return 4;                                                                           /* return error */
+    }
+    
+    *reg = (uint16_t)(mV / 1.25f);        /* convert real data to register data */
+    
+    return 0;                             /* success return 0 */
+}
+
+/**
+ * @brief      convert the register raw data to the bus voltage
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[in]  reg register raw data
+ * @param[out] *mV pointer to a millivolt buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ina226_bus_voltage_convert_to_data(ina226_handle_t *handle, uint16_t reg, float *mV)
+{
+    if (handle == NULL)                /* check handle */
+    {
+        return 2;                      /* return error */
+    }
+    if (handle->inited != 1)           /* check handle initialization */
+    {
+        return 3;                      /* return error */
+    }
+    
+    *mV = (float)(reg) * 1.25f;        /* convert real data to register data */
+    
+    return 0;                          /* success return 0 */
+}
+
+/**
+ * @brief      convert the power to the register raw data
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[in]  mW milliwatt
+ * @param[out] *reg pointer to a register raw buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 mW is out of range
+ * @note       none
+ */
+uint8_t ina226_power_convert_to_register(ina226_handle_t *handle, float mW, uint16_t *reg)
+{
+    if (handle == NULL)                                                             /* check handle */
+    {
+        return 2;                                                                   /* return error */
+    }
+    if (handle->inited != 1)                                                        /* check handle initialization */
+    {
+        return 3;                                                                   /* return error */
+    }
+    if (a_ina226_alert_threshold_check(handle, INA226_CHANNEL_POWER, mW) != 0)      /* check the range */
+    {
+        handle->debug_print("ina226: power is out of range.\n");                    /* power is out of range */
+        
+        return 4;                                                                   /* return error */
+    }
+    
+    *reg = (uint16_t)((double)(mW) / (handle->current_lsb * 25.0 * 1000.0));        /* set the converted data */
+    
+    return 0;                                                                       /* success return 0 */
+}
+
+/**
+ * @brief      convert the register raw data to the power
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[in]  reg register raw data
+ * @param[out] *mW pointer to a milliwatt buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ina226_power_convert_to_data(ina226_handle_t *handle, uint16_t reg, float *mW)
+{
+    if (handle == NULL)                                                        /* check handle */
+    {
+        return 2;                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                   /* check handle initialization */
+    {
+        return 3;                                                              /* return error */
+    }
+    
+    *mW = (float)((double)(reg) * handle->current_lsb * 25.0 * 1000.0);        /* set the converted data */
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      convert the current to the register raw data
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[in]  mA milliampere
+ * @param[out] *reg pointer to a register raw buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 mA is out of range
+ * @note       none
+ */
+uint8_t ina226_current_convert_to_register(ina226_handle_t *handle, float mA, uint16_t *reg)
+{
+    if (handle == NULL)                                                                 /* check handle */
+    {
+        return 2;                                                                       /* return error */
+    }
+    if (handle->inited != 1)                                                            /* check handle initialization */
+    {
+        return 3;                                                                       /* return error */
+    }
+    if (a_ina226_alert_threshold_check(handle, INA226_CHANNEL_CURRENT, mA) != 0)        /* check the range */
+    {
+        handle->debug_print("ina226: current is out of range.\n");                      /* current is out of range */
+        
+        return 4;                                                                       /* return error */
+    }
+    
+    *reg = (uint16_t)((int16_t)((double)(mA) / (handle->current_lsb * 1000.0)));        /* set the converted data */
+    
+    return 0;                                                                           /* success return 0 */
+}
+
+/**
+ * @brief      convert the register raw data to the current
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[in]  reg register raw data
+ * @param[out] *mA pointer to a milliampere buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ina226_current_convert_to_data(ina226_handle_t *handle, uint16_t reg, float *mA)
+{
+    if (handle == NULL)                                                          /* check handle */
+    {
+        return 2;                                                                /* return error */
+    }
+    if (handle->inited != 1)                                                     /* check handle initialization */
+    {
+        return 3;                                                                /* return error */
+    }
+    
+    *mA = (float)((double)((int16_t)reg) * handle->current_lsb * 1000.0);        /* set the converted data */
+    
+    return 0;                                                                    /* success return 0 */
+}
+
+/**
+ * @brief     run the receive callbacks
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @param[in] type irq type
+ * @note      none
+ */
+static void a_ina226_receive(ina226_handle_t *handle, uint8_t type)
+{
+    if (handle->receive_callback != NULL)                                   /* check not null */
+    {
+        handle->receive_callback(type);                                     /* run callback */
+    }
+    if (handle->receive_callback_ex != NULL)                                /* check not null */
+    {
+        handle->receive_callback_ex(handle, type, handle->user_data);       /* run callback with context */
+    }
+}
+
+/**
+ * @brief     irq handler
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ina226_irq_handler(ina226_handle_t *handle)
+{
+    uint8_t res;
+    uint16_t prev;
+   
+    if (handle == NULL)                                                                     /* check handle */
+    {
+        return 2;                                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                                /* check handle initialization */
+    {
+        return 3;                                                                           /* return error */
+    }
+    
+    res = a_ina226_iic_read(handle, INA226_REG_MASK, (uint16_t *)&prev);                    /* read mask */
+    if (res != 0)                                                                           /* check result */
+    {
+        handle->debug_print("ina226: read mask register failed.\n");                        /* read mask register failed */
+       
+        return 1;                                                                           /* return error */
+    }
+    prev |= handle->flags & (1 << 4);                                                       /* merge the sticky alert flag */
+    handle->flags &= (uint16_t)(~(1 << 4));                                                 /* clear the sticky alert flag */
+    if ((prev & (1 << 4)) != 0)                                                             /* check alert flag */
+    {
+        if ((prev & (1 << 15)) != 0)                                                        /* shunt voltage over voltage */
+        {
+            a_ina226_receive(handle, INA226_STATUS_SHUNT_VOLTAGE_OVER_VOLTAGE);             /* run callback */
+        }
+        else if ((prev & (1 << 14)) != 0)                                                   /* shunt voltage under voltage */
+        {
+            a_ina226_receive(handle, INA226_STATUS_SHUNT_VOLTAGE_UNDER_VOLTAGE);            /* run callback */
+        }
+        else if ((prev & (1 << 13)) != 0)                                                   /* bus voltage over voltage */
+        {
+            a_ina226_receive(handle, INA226_STATUS_BUS_VOLTAGE_OVER_VOLTAGE);               /* run callback */
+        }
+        else if ((prev & (1 << 12)) != 0)                                                   /* bus voltage under voltage */
+        {
+            a_ina226_receive(handle, INA226_STATUS_BUS_VOLTAGE_UNDER_VOLTAGE);              /* run callback */
+        }
+        else if ((prev & (1 << 11)) != 0)                                                   /* power over limit */
+        {
+            a_ina226_receive(handle, INA226_STATUS_POWER_OVER_LIMIT);                       /* run callback */
+        }
+        else
+        {
+                                                                                            /* do nothing */
+        }
+    }
+    
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief     irq handler with the edge timestamp
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @param[in] timestamp_us alert edge timestamp in us
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      pass the time the edge was captured in the get_time_us time base,
+ *            callbacks can read it with ina226_get_irq_timestamp
+ */
+uint8_t ina226_irq_handler_timestamp(ina226_handle_t *handle, uint64_t timestamp_us)
+{
+    if (handle == NULL)                                        /* check handle */
+    {
+        return 2;                                              /* return error */
+    }
+    if (handle->inited != 1)                                   /* check handle initialization */
+    {
+        return 3;                                              /* return error */
+    }
+    
+    a_ina226_irq_timestamp_store(handle, timestamp_us);        /* save the timestamp */
+    
+    return ina226_irq_handler(handle);                         /* run the irq handler */
+}
+
+/**
+ * @brief     set the alert edge timestamp
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @param[in] timestamp_us alert edge timestamp in us
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      when the conversion ready alert is enabled, the next sample read takes
+ *            this timestamp instead of get_time_us and clears it, 0 means none,
+ *            it can be called from an interrupt or another thread, the reader
+ *            never sees half of the 64 bits
+ */
+uint8_t ina226_set_irq_timestamp(ina226_handle_t *handle, uint64_t timestamp_us)
+{
+    if (handle == NULL)                                        /* check handle */
+    {
+        return 2;                                              /* return error */
+    }
+    
+    a_ina226_irq_timestamp_store(handle, timestamp_us);        /* save the timestamp */
+    
+    return 0;                                                  /* success return 0 */
+}
+
+/**
+ * @brief      get the alert edge timestamp
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[out] *timestamp_us pointer to a timestamp buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ *             - 2 handle or timestamp_us is NULL
+ * @note       0 means no edge is pending
+ */
+uint8_t ina226_get_irq_timestamp(ina226_handle_t *handle, uint64_t *timestamp_us)
+{
+    uint32_t seq;
+    
+    if ((handle == NULL) || (timestamp_us == NULL))                          /* check handle and timestamp */
+    {
+        return 2;                                                            /* return error */
+    }
+    
+    if (a_ina226_irq_timestamp_load(handle, timestamp_us, &seq) != 0)        /* load the timestamp */
+    {
+        return 1;                                                            /* return error */
+    }
+    
+    return 0;                                                                /* success return 0 */
+}
+
+/**
+ * @brief      get the sticky flags
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[out] *flags pointer to a flags buffer
+ * @param[in]  clear bool value
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle or flags is NULL
+ *             - 3 handle is not initialized
+ * @note       every mask register read latches the AFF, CVRF and OVF bits here,
+ *             so flags cleared on the chip by a read are not lost, no bus traffic
+ */
+uint8_t ina226_get_flags(ina226_handle_t *handle, uint16_t *flags, ina226_bool_t clear)
+{
+    if ((handle == NULL) || (flags == NULL))    /* check handle and flags */
+    {
+        return 2;                               /* return error */
+    }
+    if (handle->inited != 1)                    /* check handle initialization */
+    {
+        return 3;                               /* return error */
+    }
+    
+    *flags = handle->flags;                     /* get the flags */
+    if (clear == INA226_BOOL_TRUE)              /* check clear */
+    {
+        handle->flags = 0;                      /* clear the flags */
+    }
+    
+    return 0;                                   /* success return 0 */
+}
+
+/**
+ * @brief     set the user data
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @param[in] *user_data pointer to a user context
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      it is passed to receive_callback_ex
+ */
+uint8_t ina226_set_user_data(ina226_handle_t *handle, void *user_data)
+{
+    if (handle == NULL)                          /* check handle */
+    {
+        return 2;                                /* return error */
+    }
+    
+    handle->user_data = user_data;               /* set the user data */
+    
+    return 0;                                    /* success return 0 */
+}
+
+/**
+ * @brief      get the user data
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[out] **user_data pointer to a user context pointer buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle or user_data is NULL
+ * @note       none
+ */
+uint8_t ina226_get_user_data(ina226_handle_t *handle, void **user_data)
+{
+    if ((handle == NULL) || (user_data == NULL))        /* check handle and user data */
+    {
+        return 2;                                       /* return error */
+    }
+    
+    *user_data = handle->user_data;                     /* get the user data */
+    
+    return 0;                                           /* success return 0 */
+}
+
+/**
+ * @brief      get the driver statistics
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[out] *stats pointer to an ina226 driver stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle or stats is NULL
+ *             - 4 stats is disabled
+ * @note       build with INA226_ENABLE_STATS to enable it
+ */
+uint8_t ina226_get_stats(ina226_handle_t *handle, ina226_driver_stats_t *stats)
+{
+    if ((handle == NULL) || (stats == NULL))                    /* check handle and stats */
+    {
+        return 2;                                               /* return error */
+    }
+    
+#if (INA226_ENABLE_STATS != 0)
+    *stats = handle->stats;                                     /* copy the stats */
+    
+    return 0;                                                   /* success return 0 */
+#else
+    handle->debug_print("ina226: stats is disabled.\n");        /* stats is disabled */
+    
+    return 4;                                                   /* return error */
+#endif
+}
+
+/**
+ * @brief     clear the driver statistics
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 stats is disabled
+ * @note      build with INA226_ENABLE_STATS to enable it
+ */
+uint8_t ina226_clear_stats(ina226_handle_t *handle)
+{
+    if (handle == NULL)                                                /* check handle */
+    {
+        return 2;                                                      /* return error */
+    }
+    
+#if (INA226_ENABLE_STATS != 0)
+    memset(&handle->stats, 0, sizeof(ina226_driver_stats_t));          /* clear the stats */
+    
+    return 0;                                                          /* success return 0 */
+#else
+    handle->debug_print("ina226: stats is disabled.\n");               /* stats is disabled */
+    
+    return 4;                                                          /* return error */
+#endif
+}
+
+/**
+ * @brief     set the flags callback
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @param[in] *callback pointer to a flags callback function address
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      callback can be NULL to disable it,
+ *            it gets the context set by ina226_set_user_data
+ */
+uint8_t ina226_set_flags_callback(ina226_handle_t *handle, void (*callback)(ina226_handle_t *handle, uint16_t flags, void *user_data))
+{
+    if (handle == NULL)                         /* check handle */
+    {
+        return 2;                               /* return error */
+    }
+    
+    handle->flags_callback = callback;          /* set the callback */
+    
+    return 0;                                   /* success return 0 */
+}
+
+/**
+ * @brief      irq handler with all flags
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[out] *flags pointer to a flags buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the whole mask register is passed to the flags callback in one call,
+ *             the sticky flags are merged in and cleared,
+ *             see ina226_flag_t for the bits, flags can be NULL
+ */
+uint8_t ina226_irq_handler_ex(ina226_handle_t *handle, uint16_t *flags)
+{
+    uint8_t res;
+    uint16_t prev;
+    
+    if (handle == NULL)                                                            /* check handle */
+    {
+        return 2;                                                                  /* return error */
+    }
+    if (handle->inited != 1)                                                       /* check handle initialization */
+    {
+        return 3;                                                                  /* return error */
+    }
+    
+    res = a_ina226_iic_read(handle, INA226_REG_MASK, (uint16_t *)&prev);           /* read mask */
+    if (res != 0)                                                                  /* check result */
+    {
+        handle->debug_print("ina226: read mask register failed.\n");               /* read mask register failed */
+       
+        return 1;                                                                  /* return error */
+    }
+    prev |= handle->flags;                                                         /* merge the sticky flags */
+    handle->flags = 0;                                                             /* clear the sticky flags */
+    if (flags != NULL)                                                             /* check flags */
+    {
+        *flags = prev;                                                             /* save the flags */
+    }
+    if (handle->flags_callback != NULL)                                            /* check not null */
+    {
+        handle->flags_callback(handle, prev, handle->user_data);                   /* run callback with context */
+    }
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief     initialize the chip
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic initialization failed
+ *            - 2 handle is NULL
+ *            - 3 linked functions is NULL
+ *            - 4 id is invalid
+ *            - 5 soft reset failed
+ * @note      none
+ */
+uint8_t ina226_init(ina226_handle_t *handle)
+{
+    uint8_t res;
+    uint8_t i;
+    uint16_t prev;
+    
+    if (handle == NULL)                                                                /* check handle */
+    {
+        return 2;                                                                      /* return error */
+    }
+    if (handle->debug_print == NULL)                                                   /* check debug_print */
+    {
+        return 3;                                                                      /* return error */
+    }
+    if (handle->iic_init == NULL)                                                      /* check iic_init */
+    {
+        handle->debug_print("ina226: iic_init is null.\n");                            /* iic_init is null */
+        
+        return 3;                                                                      /* return error */
+    }
+    if (handle->iic_deinit == NULL)                                                    /* check iic_deinit */
+    {
+        handle->debug_print("ina226: iic_deinit is null.\n");                          /* iic_deinit is null */
+        
+        return 3;                                                                      /* return error */
+    }
+    if (handle->iic_read == NULL)                                                      /* check iic_read */
+    {
+        handle->debug_print("ina226: iic_read is null.\n");                            /* iic_read is null */
+        
+        return 3;                                                                      /* return error */
+    }
+    if (handle->iic_write == NULL)                                                     /* check iic_write */
+    {
+        handle->debug_print("ina226: iic_write is null.\n");                           /* iic_write is null */
+        
+        return 3;                                                                      /* return error */
+    }
+    if (handle->delay_ms == NULL)                                                      /* check delay_ms */
+    {
+        handle->debug_print("ina226: delay_ms is null.\n");                            /* delay_ms is null */
+        
+        return 3;                                                                      /* return error */
+    }
+    if ((handle->receive_callback == NULL) && 
+        (handle->receive_callback_ex == NULL))                                         /* check receive_callback */
+    {
+        handle->debug_print("ina226: receive_callback is null.\n");                    /* receive_callback is null */
+        
+        return 3;                                                                      /* return error */
+    }
+    
+    if (handle->iic_init() != 0)                                                       /* iic init */
+    {
+        handle->debug_print("ina226: iic init failed.\n");                             /* iic init failed */
+        
+        return 1;                                                                      /* return error */
+    }
+    handle->pointer_valid = 0;                                                         /* pointer is unknown */
+    handle->flags = 0;                                                                 /* clear the sticky flags */
+    handle->irq_used = handle->irq_seq;                                                /* no edge */
+    res = a_ina226_iic_read(handle, INA226_REG_MANUFACTURER, (uint16_t *)&prev);       /* read manufacturer */
+    if (res != 0)                                                                      /* check result */
+    {
+        handle->debug_print("ina226: read manufacturer failed.\n");                    /* read manufacturer failed */
+        (void)handle->iic_deinit();                                                    /* iic deinit */
+       
+        return 4;                                                                      /* return error */
+    }
+    if (prev != 0x5449)                                                                /* check id */
+    {
+        handle->debug_print("ina226: id is invalid.\n");                               /* id is invalid */
+        (void)handle->iic_deinit();                                                    /* iic deinit */
+       
+        return 4;                                                                      /* return error */
+    }
+    res = a_ina226_iic_read(handle, INA226_REG_CONF, (uint16_t *)&prev);               /* read conf */
+    if (res != 0)                                                                      /* check result */
+    {
+        handle->debug_print("ina226: read conf register failed.\n");                   /* read conf register failed */
+        (void)handle->iic_deinit();                                                    /* iic deinit */
+       
+        return 5;                                                                      /* return error */
+    }
+    prev |= 1 << 15;                                                                   /* set bit */
+    res = a_ina226_iic_write(handle, INA226_REG_CONF, prev);                           /* write conf */
+    if (res != 0)                                                                      /* check result */
+    {
+        handle->debug_print("ina226: write conf register failed.\n");                  /* write conf register failed */
+        (void)handle->iic_deinit();                                                    /* iic deinit */
+        
+        return 5;                                                                      /* return error */
+    }
+    for (i = 0; i < 10; i++)                                                           /* wait the reset bit */
+    {
+        res = a_ina226_iic_read(handle, INA226_REG_CONF, (uint16_t *)&prev);           /* read conf */
+        if (res != 0)                                                                  /* check result */
+        {
+            handle->debug_print("ina226: read conf register failed.\n");               /* read conf register failed */
+            (void)handle->iic_deinit();                                                /* iic deinit */
+            
+            return 5;                                                                  /* return error */
+        }
+        if ((prev & (1 << 15)) == 0)                                                   /* check reset finished */
+        {
+            break;                                                                     /* break */
+        }
+        handle->delay_ms(1);                                                           /* delay 1 ms */
+    }
+    if ((prev & (1 << 15)) != 0)                                                       /* check the result */
+    {
+        handle->debug_print("ina226: soft reset failed.\n");                           /* soft reset failed */
+        (void)handle->iic_deinit();                                                    /* iic deinit */
+        
+        return 5;                                                                      /* return error */
+    }
+    handle->trigger = 0;                                                               /* none */
+    handle->finished = 0;                                                              /* none */
+    handle->inited = 1;                                                                /* flag inited */
+    
+    return 0;                                                                          /* success return 0 */
+}
+
+/**
+ * @brief     close the chip
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic deinit failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 power down failed
+ * @note      none
+ */
+uint8_t ina226_deinit(ina226_handle_t *handle)
+{
+    uint8_t res;
+    uint16_t prev;
+   
+    if (handle == NULL)                                                        /* check handle */
+    {
+        return 2;                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                   /* check handle initialization */
+    {
+        return 3;                                                              /* return error */
+    }
+    
+    res = a_ina226_shadow_read(handle, INA226_REG_CONF, (uint16_t *)&prev);    /* read config */
+    if (res != 0)                                                              /* check result */
+    {
+        handle->debug_print("ina226: read conf register failed.\n");           /* read conf register failed */
+       
+        return 4;                                                              /* return error */
+    }
+    prev &= ~(0x07);                                                           /* clear mode */
+    res = a_ina226_iic_write(handle, INA226_REG_CONF, (uint16_t )prev);        /* write config */
+    if (res != 0)                                                              /* check result */
+    {
+        handle->debug_print("ina226: write conf register failed.\n");          /* write conf register failed */
+       
+        return 4;                                                              /* return error */
+    }
+    res = handle->iic_deinit();                                                /* iic deinit */
+    if (res != 0)                                                              /* check result */
+    {
+        handle->debug_print("ina226: iic deinit failed.\n");                   /* iic deinit failed */
+       
+        return 1;                                                              /* return error */
+    }
+    
+    return 0;                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     set the chip register
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @param[in] reg register address
+ * @param[in] data written data
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ina226_set_reg(ina226_handle_t *handle, uint8_t reg, uint16_t data)
+{
+    if (handle == NULL)                                 /* check handle */
+    {
+        return 2;                                       /* return error */
+    }
+    if (handle->inited != 1)                            /* check handle initialization */
+    {
+        return 3;                                       /* return error */
+    }
+    
+    return a_ina226_iic_write(handle, reg, data);       /* write data */
+}
+
+/**
+ * @brief      get the chip register
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[in]  reg register address
+ * @param[out] *data pointer to a data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ina226_get_reg(ina226_handle_t *handle, uint8_t reg, uint16_t *data)
+{
+    if (handle == NULL)                                /* check handle */
+    {
+        return 2;                                      /* return error */
+    }
+    if (handle->inited != 1)                           /* check handle initialization */
+    {
+        return 3;                                      /* return error */
+    }
+    
+    return a_ina226_iic_read(handle, reg, data);       /* read data */
+}
+
+/**
+ * @brief     initialize the bus manager
+ * @param[in] *bus pointer to an ina226 bus structure
+ * @param[in] *get_time_us pointer to a get_time_us function address
+ * @return    status code
+ *            - 0 success
+ *            - 2 bus is NULL
+ * @note      get_time_us can be NULL, then the frame timestamp is 0
+ */
+uint8_t ina226_bus_init(ina226_bus_t *bus, uint64_t (*get_time_us)(void))
+{
+    if (bus == NULL)                             /* check bus */
+    {
+        return 2;                                /* return error */
+    }
+    
+    memset(bus, 0, sizeof(ina226_bus_t));        /* clear the bus */
+    bus->get_time_us = get_time_us;              /* set the time hook */
+    
+    return 0;                                    /* success return 0 */
+}
+
+/**
+ * @brief      add a device to the bus manager
+ * @param[in]  *bus pointer to an ina226 bus structure
+ * @param[in]  *handle pointer to a linked ina226 handle structure
+ * @param[in]  divider sweep rate divider
+ * @param[out] *index pointer to a device index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 add device failed
+ *             - 2 bus, handle or index is NULL
+ *             - 4 bus is full
+ *             - 5 divider is invalid
+ * @note       the handle is copied into the bus and initialized there,
+ *             the caller's handle is not used afterwards
+ */
+uint8_t ina226_bus_add_device(ina226_bus_t *bus, const ina226_handle_t *handle, uint8_t divider, uint8_t *index)
+{
+    uint8_t res;
+    ina226_handle_t *device;
+    
+    if ((bus == NULL) || (handle == NULL) || 
+        (index == NULL))                                    /* check bus, handle and index */
+    {
+        return 2;                                           /* return error */
+    }
+    if (bus->num >= INA226_BUS_MAX_DEVICE)                  /* check the bus */
+    {
+        return 4;                                           /* return error */
+    }
+    if (divider == 0)                                       /* check the divider */
+    {
+        return 5;                                           /* return error */
+    }
+    
+    device = &bus->device[bus->num];                        /* get the device */
+    memcpy(device, handle, sizeof(ina226_handle_t));        /* copy the handle */
+    device->inited = 0;                                     /* not initialized */
+    res = ina226_init(device);                              /* init the device */
+    if (res != 0)                                           /* check result */
+    {
+        return 1;                                           /* return error */
+    }
+    bus->divider[bus->num] = divider;                       /* set the divider */
+    *index = bus->num;                                      /* set the index */
+    bus->num++;                                             /* num++ */
+    
+    return 0;                                               /* success return 0 */
+}
+
+/**
+ * @brief      get a device handle of the bus manager
+ * @param[in]  *bus pointer to an ina226 bus structure
+ * @param[in]  index device index
+ * @param[out] **handle pointer to a device handle pointer buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 bus or handle is NULL
+ *             - 4 index is invalid
+ * @note       use it to configure the device with the basic driver functions
+ */
+uint8_t ina226_bus_get_handle(ina226_bus_t *bus, uint8_t index, ina226_handle_t **handle)
+{
+    if ((bus == NULL) || (handle == NULL))        /* check bus and handle */
+    {
+        return 2;                                 /* return error */
+    }
+    if (index >= bus->num)                        /* check index */
+    {
+        return 4;                                 /* return error */
+    }
+    
+    *handle = &bus->device[index];                /* set the handle */
+    
+    return 0;                                     /* success return 0 */
+}
+
+/**
+ * @brief      read scheduled devices in one bus transaction
+ * @param[in]  *bus pointer to an ina226 bus structure
+ * @param[in]  *index pointer to a device index array
+ * @param[in]  num device number
+ * @param[out] *frame pointer to a bus frame structure
+ * @note       each device reads mask, results, shunt voltage and current again,
+ *             a device with changed data is read again alone
+ */
+static void a_ina226_bus_sweep_batch(ina226_bus_t *bus, const uint8_t *index, uint8_t num, ina226_bus_frame_t *frame)
+{
+    uint8_t i;
+    uint8_t k;
+    uint8_t n;
+    uint8_t res;
+    uint8_t batch;
+    uint8_t reg[INA226_READ_BATCH_MAX];
+    uint16_t data[INA226_READ_BATCH_MAX];
+    uint64_t timestamp[INA226_READ_BATCH_MAX / 7];
+    ina226_handle_t *h[INA226_READ_BATCH_MAX];
+    ina226_handle_t *handle;
+    ina226_sample_t *sample;
+    
+    n = 0;                                                                                      /* init 0 */
+    for (i = 0; i < num; i++)                                                                   /* set all devices */
+    {
+        handle = &bus->device[index[i]];                                                        /* get the handle */
+        timestamp[i] = a_ina226_sample_timestamp(handle);                                       /* get the timestamp */
+        h[n] = handle;                                                                          /* set the handle */
+        reg[n++] = INA226_REG_MASK;                                                             /* read mask first */
+        for (k = 0; k < 6; k++)                                                                 /* results and check */
+        {
+            h[n] = handle;                                                                      /* set the handle */
+            reg[n++] = gs_sample_reg[k];                                                        /* set the register */
+        }
+    }
+    batch = a_ina226_iic_read_batch(h, reg, data, n);                                           /* read all items */
+    for (i = 0; i < num; i++)                                                                   /* check all devices */
+    {
+        handle = &bus->device[index[i]];                                                        /* get the handle */
+        sample = &frame->sample[index[i]];                                                      /* get the sample */
+        res = 0;                                                                                /* init 0 */
+        if (batch != 0)                                                                         /* batch failed */
+        {
+            res = ina226_read_all(handle, sample);                                              /* read the device alone */
+        }
+        else if ((data[i * 7] & (1 << 2)) != 0)                                                 /* check math overflow */
+        {
+            handle->debug_print("ina226: math overflow.\n");                                    /* math overflow */
+            res = 4;                                                                            /* set error */
+        }
+        else if ((data[i * 7 + 5] != data[i * 7 + 1]) || 
+                 (data[i * 7 + 6] != data[i * 7 + 3]))                                          /* check the data changed */
+        {
+            res = ina226_read_all(handle, sample);                                              /* read the device alone */
+        }
+        else
+        {
+            sample->timestamp_us = timestamp[i];                                                /* set the timestamp */
+            sample->shunt_voltage_raw = (int16_t)data[i * 7 + 1];                               /* set the shunt voltage raw */
+            sample->bus_voltage_raw = data[i * 7 + 2];                                          /* set the bus voltage raw */
+            sample->current_raw = (int16_t)data[i * 7 + 3];                                     /* set the current raw */
+            sample->power_raw = data[i * 7 + 4];                                                /* set the power raw */
+            sample->mixed = 0;                                                                  /* init 0 */
+            a_ina226_convert_sample(handle, sample);                                            /* convert the sample */
+        }
+        if (res != 0)                                                                           /* check result */
+        {
+            frame->error |= (uint32_t)1 << index[i];                                            /* set the error */
+        }
+        else
+        {
+            frame->valid |= (uint32_t)1 << index[i];                                            /* set the valid */
+        }
+    }
+}
+
+/**
+ * @brief      read all scheduled devices once
+ * @param[in]  *bus pointer to an ina226 bus structure
+ * @param[out] *frame pointer to a bus frame structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 sweep failed
+ *             - 2 bus or frame is NULL
+ * @note       a device is read when the sweep sequence is a multiple of its divider,
+ *             failed devices are reported in the frame error mask
+ */
+uint8_t ina226_bus_sweep(ina226_bus_t *bus, ina226_bus_frame_t *frame)
+{
+    uint8_t i;
+    uint8_t n;
+    uint8_t index[INA226_BUS_MAX_DEVICE];
+    
+    if ((bus == NULL) || (frame == NULL))                                             /* check bus and frame */
+    {
+        return 2;                                                                     /* return error */
+    }
+    
+    frame->timestamp_us = (bus->get_time_us != NULL) ? bus->get_time_us() : 0;        /* set the timestamp */
+    frame->sequence = bus->sequence;                                                  /* set the sequence */
+    frame->valid = 0;                                                                 /* init 0 */
+    frame->error = 0;                                                                 /* init 0 */
+    n = 0;                                                                            /* init 0 */
+    for (i = 0; i < bus->num; i++)                                                    /* loop all devices */
+    {
+        if ((bus->sequence % bus->divider[i]) != 0)                                   /* check the rate */
+        {
+            continue;                                                                 /* skip */
+        }
+        if ((bus->device[i].iic_read_batch != NULL) && 
+            (bus->device[i].trigger == 0))                                            /* check batch read */
+        {
+            index[n++] = i;                                                           /* read it in a batch */
+            if (n == (INA226_READ_BATCH_MAX / 7))                                     /* check batch size */
+            {
+                a_ina226_bus_sweep_batch(bus, index, n, frame);                       /* read the batch */
+                n = 0;                                                                /* clear the number */
+            }
+            
+            continue;                                                                 /* next */
+        }
+        if (ina226_read_all(&bus->device[i], &frame->sample[i]) != 0)                 /* read the device */
+        {
+            frame->error |= (uint32_t)1 << i;                                         /* set the error */
+        }
+        else
+        {
+            frame->valid |= (uint32_t)1 << i;                                         /* set the valid */
+        }
+    }
+    if (n != 0)                                                                       /* check the rest */
+    {
+        a_ina226_bus_sweep_batch(bus, index, n, frame);                               /* read the batch */
+    }
+    bus->sequence++;                                                                  /* sequence++ */
+    if ((frame->error != 0) && (frame->valid == 0))                                   /* check all failed */
+    {
+        return 1;                                                                     /* return error */
+    }
+    
+    return 0;                                                                         /* success return 0 */
+}
+
+/**
+ * @brief     deinit all devices of the bus manager
+ * @param[in] *bus pointer to an ina226 bus structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ *            - 2 bus is NULL
+ * @note      none
+ */
+uint8_t ina226_bus_deinit(ina226_bus_t *bus)
+{
+    uint8_t i;
+    uint8_t res;
+    
+    if (bus == NULL)                                    /* check bus */
+    {
+        return 2;                                       /* return error */
+    }
+    
+    res = 0;                                            /* init 0 */
+    for (i = 0; i < bus->num; i++)                      /* loop all devices */
+    {
+        if (ina226_deinit(&bus->device[i]) != 0)        /* deinit the device */
+        {
+            res = 1;                                    /* set failed */
+        }
+    }
+    bus->num = 0;                                       /* clear the num */
+    
+    return res;                                         /* return the result */
+}
+
+/**
+ * @brief     initialize the sample ring
+ * @param[in] *ring pointer to an ina226 ring structure
+ * @param[in] *buf pointer to a sample storage buffer
+ * @param[in] size storage size
+ * @return    status code
+ *            - 0 success
+ *            - 2 ring or buf is NULL
+ *            - 4 size is not a power of 2
+ * @note      the ring holds size - 1 samples,
+ *            one producer and one consumer may use it without a lock
+ */
+uint8_t ina226_ring_init(ina226_ring_t *ring, ina226_sample_t *buf, uint32_t size)
+{
+    if ((ring == NULL) || (buf == NULL))                 /* check ring and buf */
+    {
+        return 2;                                        /* return error */
+    }
+    if ((size < 2) || ((size & (size - 1)) != 0))        /* check size */
+    {
+        return 4;                                        /* return error */
+    }
+    
+    ring->buf = buf;                                     /* set the storage */
+    ring->size = size;                                   /* set the size */
+    ring->mask = size - 1;                               /* set the mask */
+    ring->head = 0;                                      /* clear the head */
+    ring->tail = 0;                                      /* clear the tail */
+    ring->overrun = 0;                                   /* clear the overrun */
+    
+    return 0;                                            /* success return 0 */
+}
+
+/**
+ * @brief     push a sample into the ring
+ * @param[in] *ring pointer to an ina226 ring structure
+ * @param[in] *sample pointer to a sample structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 ring or sample is NULL
+ *            - 4 ring is full
+ * @note      producer side only, a full ring drops the sample and counts an overrun
+ */
+uint8_t ina226_ring_push(ina226_ring_t *ring, const ina226_sample_t *sample)
+{
+    uint32_t head;
+    
+    if ((ring == NULL) || (sample == NULL))             /* check ring and sample */
+    {
+        return 2;                                       /* return error */
+    }
+    
+    head = ring->head;                                  /* get the head */
+    if (((head + 1) & ring->mask) == ring->tail)        /* check full */
+    {
+        ring->overrun++;                                /* overrun++ */
+        
+        return 4;                                       /* return error */
+    }
+    ring->buf[head] = *sample;                          /* copy the sample */
+    INA226_MEMORY_BARRIER();                            /* publish the sample before the index */
+    ring->head = (head + 1) & ring->mask;               /* move the head */
+    
+    return 0;                                           /* success return 0 */
+}
+
+/**
+ * @brief         pop samples from the ring
+ * @param[in]     *ring pointer to an ina226 ring structure
+ * @param[out]    *sample pointer to a sample buffer
+ * @param[in,out] *len pointer to a buffer length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 2 ring, sample or len is NULL
+ * @note          consumer side only, len returns the popped sample number
+ */
+uint8_t ina226_ring_pop(ina226_ring_t *ring, ina226_sample_t *sample, uint32_t *len)
+{
+    uint32_t i;
+    uint32_t head;
+    uint32_t tail;
+    
+    if ((ring == NULL) || (sample == NULL) || (len == NULL))        /* check ring, sample and len */
+    {
+        return 2;                                                   /* return error */
+    }
+    
+    head = ring->head;                                              /* get the head */
+    INA226_MEMORY_BARRIER();                                        /* read the index before the samples */
+    tail = ring->tail;                                              /* get the tail */
+    for (i = 0; (i < (*len)) && (tail != head); i++)                /* copy all available samples */
+    {
+        sample[i] = ring->buf[tail];                                /* copy the sample */
+        tail = (tail + 1) & ring->mask;                             /* next */
+    }
+    INA226_MEMORY_BARRIER();                                        /* finish the copy before releasing the slots */
+    ring->tail = tail;                                              /* move the tail */
+    *len = i;                                                       /* set the popped number */
+    
+    return 0;                                                       /* success return 0 */
+}
+
+/**
+ * @brief      get the sample number in the ring
+ * @param[in]  *ring pointer to an ina226 ring structure
+ * @param[out] *count pointer to a count buffer
+ * @param[out] *overrun pointer to an overrun counter buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 ring, count or overrun is NULL
+ * @note       none
+ */
+uint8_t ina226_ring_get_count(ina226_ring_t *ring, uint32_t *count, uint32_t *overrun)
+{
+    if ((ring == NULL) || (count == NULL) || (overrun == NULL))        /* check ring, count and overrun */
+    {
+        return 2;                                                      /* return error */
+    }
+    
+    *count = (ring->head - ring->tail) & ring->mask;                   /* get the count */
+    *overrun = ring->overrun;                                          /* get the overrun */
+    
+    return 0;                                                          /* success return 0 */
+}
+
+/**
+ * @brief     read all results and push them into the ring
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @param[in] *ring pointer to an ina226 ring structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ *            - 2 handle or ring is NULL
+ *            - 3 handle is not initialized
+ *            - 4 ring is full
+ * @note      producer side only
+ */
+uint8_t ina226_read_to_ring(ina226_handle_t *handle, ina226_ring_t *ring)
+{
+    uint8_t res;
+    ina226_sample_t sample;
+    
+    if ((handle == NULL) || (ring == NULL))                       /* check handle and ring */
+    {
+        return 2;                                                 /* return error */
+    }
+    if (handle->inited != 1)                                      /* check handle initialization */
+    {
+        return 3;                                                 /* return error */
+    }
+    
+    res = ina226_read_all(handle, &sample);                       /* read all */
+    if (res != 0)                                                 /* check result */
+    {
+        handle->debug_print("ina226: read all failed.\n");        /* read all failed */
+        
+        return 1;                                                 /* return error */
+    }
+    if (ina226_ring_push(ring, &sample) != 0)                     /* push the sample */
+    {
+        handle->debug_print("ina226: ring is full.\n");           /* ring is full */
+        
+        return 4;                                                 /* return error */
+    }
+    
+    return 0;                                                     /* success return 0 */
+}
+
+/**
+ * @brief     publish the latest sample
+ * @param[in] *latest pointer to an ina226 latest structure
+ * @param[in] *sample pointer to a sample structure
+ * @param[in] flags sticky flags
+ * @return    status code
+ *            - 0 success
+ *            - 2 latest or sample is NULL
+ * @note      single writer, a zeroed structure is a valid empty slot
+ */
+uint8_t ina226_latest_publish(ina226_latest_t *latest, const ina226_sample_t *sample, uint16_t flags)
+{
+    uint32_t seq;
+    
+    if ((latest == NULL) || (sample == NULL))        /* check latest and sample */
+    {
+        return 2;                                    /* return error */
+    }
+    
+    seq = latest->seq;                               /* get the sequence */
+    latest->seq = seq + 1;                           /* mark as written */
+    INA226_MEMORY_BARRIER();                         /* mark before the data */
+    latest->flags = flags;                           /* set the flags */
+    latest->sample = *sample;                        /* copy the sample */
+    INA226_MEMORY_BARRIER();                         /* data before the mark */
+    seq += 2;                                        /* next sequence */
+    if (seq == 0)                                    /* check wrap */
+    {
+        seq = 2;                                     /* 0 marks an empty slot */
+    }
+    latest->seq = seq;                               /* mark as done */
+    
+    return 0;                                        /* success return 0 */
+}
+
+/**
+ * @brief      read the latest sample
+ * @param[in]  *latest pointer to an ina226 latest structure
+ * @param[out] *sample pointer to a sample buffer
+ * @param[out] *flags pointer to a flags buffer
+ * @param[out] *seq pointer to a sequence buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 latest or sample is NULL
+ *             - 4 no sample
+ * @note       any number of readers, no lock is taken, the copy is retried while the writer
+ *             is inside, 1 is returned after INA226_LATEST_RETRY tries,
+ *             seq grows by 2 per sample and skips 0 on wrap, flags and seq can be NULL
+ */
+uint8_t ina226_latest_read(const ina226_latest_t *latest, ina226_sample_t *sample, uint16_t *flags, uint32_t *seq)
+{
+    uint32_t i;
+    uint32_t start;
+    uint16_t f;
+    
+    if ((latest == NULL) || (sample == NULL))        /* check latest and sample */
+    {
+        return 2;                                    /* return error */
+    }
+    
+    for (i = 0; i < INA226_LATEST_RETRY; i++)        /* retry */
+    {
+        start = latest->seq;                         /* get the sequence */
+        if (start == 0)                              /* check empty */
+        {
+            return 4;                                /* return error */
+        }
+        if ((start & 1) != 0)                        /* check writing */
+        {
+            continue;                                /* try again */
+        }
+        INA226_MEMORY_BARRIER();                     /* mark before the data */
+        f = latest->flags;                           /* copy the flags */
+        *sample = latest->sample;                    /* copy the sample */
+        INA226_MEMORY_BARRIER();                     /* data before the mark */
+        if (latest->seq == start)                    /* check unchanged */
+        {
+            if (flags != NULL)                       /* check flags */
+            {
+                *flags = f;                          /* set the flags */
+            }
+            if (seq != NULL)                         /* check seq */
+            {
+                *seq = start;                        /* set the sequence */
+            }
+            
+            return 0;                                /* success return 0 */
+        }
+    }
+    
+    return 1;                                        /* return error */
+}
+
+/**
+ * @brief     reset the energy accumulator
+ * @param[in] *energy pointer to an ina226 energy structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 energy is NULL
+ * @note      none
+ */
+uint8_t ina226_energy_reset(ina226_energy_t *energy)
+{
+    if (energy == NULL)                                /* check energy */
+    {
+        return 2;                                      /* return error */
+    }
+    
+    memset(energy, 0, sizeof(ina226_energy_t));        /* clear the energy */
+    
+    return 0;                                          /* success return 0 */
+}
+
+/**
+ * @brief     integrate a sample into the energy accumulator
+ * @param[in] *energy pointer to an ina226 energy structure
+ * @param[in] *sample pointer to a timestamped sample structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 energy or sample is NULL
+ *            - 4 timestamp is not increasing
+ * @note      the raw registers are integrated with the trapezoid rule in 64 bits,
+ *            the first sample after a reset only sets the start point
+ */
+uint8_t ina226_energy_update(ina226_energy_t *energy, const ina226_sample_t *sample)
+{
+    uint64_t dt;
+    
+    if ((energy == NULL) || (sample == NULL))                                      /* check energy and sample */
+    {
+        return 2;                                                                  /* return error */
+    }
+    
+    if (energy->count != 0)                                                        /* check the start point */
+    {
+        if (sample->timestamp_us <= energy->last_us)                               /* check timestamp */
+        {
+            return 4;                                                              /* return error */
+        }
+        dt = sample->timestamp_us - energy->last_us;                               /* get the delta time */
+        energy->charge_raw += ((int64_t)energy->last_current_raw + 
+                               (int64_t)sample->current_raw) * (int64_t)dt;        /* integrate current */
+        energy->energy_raw += ((uint64_t)energy->last_power_raw + 
+                               (uint64_t)sample->power_raw) * dt;                  /* integrate power */
+        energy->elapsed_us += dt;                                                  /* add the delta time */
+    }
+    energy->last_us = sample->timestamp_us;                                        /* save the timestamp */
+    energy->last_current_raw = sample->current_raw;                                /* save the current */
+    energy->last_power_raw = sample->power_raw;                                    /* save the power */
+    energy->count++;                                                               /* count++ */
+    
+    return 0;                                                                      /* success return 0 */
+}
+
+/**
+ * @brief      copy the energy accumulator
+ * @param[in]  *energy pointer to an ina226 energy structure
+ * @param[out] *snapshot pointer to an ina226 energy snapshot buffer
+ * @param[in]  reset bool value
+ * @return     status code
+ *             - 0 success
+ *             - 2 energy or snapshot is NULL
+ * @note       reset restarts the integration from the last sample
+ */
+uint8_t ina226_energy_snapshot(ina226_energy_t *energy, ina226_energy_t *snapshot, ina226_bool_t reset)
+{
+    if ((energy == NULL) || (snapshot == NULL))        /* check energy and snapshot */
+    {
+        return 2;                                      /* return error */
+    }
+    
+    *snapshot = *energy;                               /* copy the energy */
+    if (reset == INA226_BOOL_TRUE)                     /* check reset */
+    {
+        energy->charge_raw = 0;                        /* clear the charge */
+        energy->energy_raw = 0;                        /* clear the energy */
+        energy->elapsed_us = 0;                        /* clear the elapsed time */
+    }
+    
+    return 0;                                          /* success return 0 */
+}
+
+/**
+ * @brief      get the accumulated charge and energy
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[in]  *energy pointer to an ina226 energy structure
+ * @param[out] *charge_mC pointer to a charge buffer
+ * @param[out] *energy_mJ pointer to an energy buffer
+ * @param[out] *elapsed_us pointer to an elapsed time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle or energy is NULL
+ *             - 3 handle is not initialized
+ * @note       the current lsb of the handle is applied here,
+ *             so it must not change during the integration
+ */
+uint8_t ina226_energy_get(ina226_handle_t *handle, const ina226_energy_t *energy, 
+                          double *charge_mC, double *energy_mJ, uint64_t *elapsed_us)
+{
+    if ((handle == NULL) || (energy == NULL))                                                     /* check handle and energy */
+    {
+        return 2;                                                                                 /* return error */
+    }
+    if (handle->inited != 1)                                                                      /* check handle initialization */
+    {
+        return 3;                                                                                 /* return error */
+    }
+    
+    *charge_mC = (double)energy->charge_raw * handle->current_lsb * 1000.0 / 2.0e6;               /* convert the charge */
+    *energy_mJ = (double)energy->energy_raw * handle->current_lsb * 25.0 * 1000.0 / 2.0e6;        /* convert the energy */
+    *elapsed_us = energy->elapsed_us;                                                             /* get the elapsed time */
+    
+    return 0;                                                                                     /* success return 0 */
+}
+
+/**
+ * @brief     get the channel raw data of a sample
+ * @param[in] *sample pointer to a sample structure
+ * @param[in] channel sample channel
+ * @return    channel raw data
+ * @note      none
+ */
+static int32_t a_ina226_sample_raw(const ina226_sample_t *sample, ina226_channel_t channel)
+{
+    if (channel == INA226_CHANNEL_SHUNT_VOLTAGE)               /* shunt voltage */
+    {
+        return sample->shunt_voltage_raw;                      /* return the shunt voltage */
+    }
+    else if (channel == INA226_CHANNEL_BUS_VOLTAGE)            /* bus voltage */
+    {
+        return sample->bus_voltage_raw;                        /* return the bus voltage */
+    }
+    else if (channel == INA226_CHANNEL_CURRENT)                /* current */
+    {
+        return sample->current_raw;                            /* return the current */
+    }
+    else                                                       /* power */
+    {
+        return sample->power_raw;                              /* return the power */
     }
-    if (handle->inited != 1)                           /* check handle initialization */
+}
+
+/**
+ * @brief     initialize the channel statistics
+ * @param[in] *stats pointer to an ina226 stats structure
+ * @param[in] channel sample channel
+ * @return    status code
+ *            - 0 success
+ *            - 2 stats is NULL
+ * @note      none
+ */
+uint8_t ina226_stats_init(ina226_stats_t *stats, ina226_channel_t channel)
+{
+    if (stats == NULL)                               /* check stats */
     {
-        return 3;                                      /* return error */
+        return 2;                                    /* return error */
     }
     
-    return a_ina226_iic_read(handle, reg, data);       /* read data */
+    memset(stats, 0, sizeof(ina226_stats_t));        /* clear the stats */
+    stats->channel = channel;                        /* set the channel */
+    
+    return 0;                                        /* success return 0 */
+}
+
+/**
+ * @brief     add a sample to the channel statistics
+ * @param[in] *stats pointer to an ina226 stats structure
+ * @param[in] *sample pointer to a sample structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 stats or sample is NULL
+ * @note      only the raw register of the channel is accumulated
+ */
+uint8_t ina226_stats_update(ina226_stats_t *stats, const ina226_sample_t *sample)
+{
+    int32_t raw;
+    int64_t d;
+    
+    if ((stats == NULL) || (sample == NULL))                      /* check stats and sample */
+    {
+        return 2;                                                 /* return error */
+    }
+    
+    raw = a_ina226_sample_raw(sample, stats->channel);            /* get the channel raw */
+    if (stats->count == 0)                                        /* first sample */
+    {
+        stats->offset = raw;                                      /* set the offset */
+        stats->min = raw;                                         /* set the min */
+        stats->max = raw;                                         /* set the max */
+    }
+    if (raw < stats->min)                                         /* check min */
+    {
+        stats->min = raw;                                         /* set the min */
+    }
+    if (raw > stats->max)                                         /* check max */
+    {
+        stats->max = raw;                                         /* set the max */
+    }
+    d = (int64_t)raw - stats->offset;                             /* shift by the offset */
+    stats->sum += d;                                              /* add to the sum */
+    stats->sumsq += (uint64_t)(d * d);                            /* add to the square sum */
+    stats->count++;                                               /* count++ */
+    
+    return 0;                                                     /* success return 0 */
+}
+
+/**
+ * @brief      copy the channel statistics
+ * @param[in]  *stats pointer to an ina226 stats structure
+ * @param[out] *snapshot pointer to an ina226 stats snapshot buffer
+ * @param[in]  reset bool value
+ * @return     status code
+ *             - 0 success
+ *             - 2 stats or snapshot is NULL
+ * @note       reset starts a new window
+ */
+uint8_t ina226_stats_snapshot(ina226_stats_t *stats, ina226_stats_t *snapshot, ina226_bool_t reset)
+{
+    if ((stats == NULL) || (snapshot == NULL))                 /* check stats and snapshot */
+    {
+        return 2;                                              /* return error */
+    }
+    
+    *snapshot = *stats;                                        /* copy the stats */
+    if (reset == INA226_BOOL_TRUE)                             /* check reset */
+    {
+        (void)ina226_stats_init(stats, stats->channel);        /* start a new window */
+    }
+    
+    return 0;                                                  /* success return 0 */
+}
+
+/**
+ * @brief      get the channel statistics
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[in]  *stats pointer to an ina226 stats structure
+ * @param[out] *min pointer to a min buffer
+ * @param[out] *max pointer to a max buffer
+ * @param[out] *mean pointer to a mean buffer
+ * @param[out] *stddev pointer to a sample standard deviation buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle or stats is NULL
+ *             - 3 handle is not initialized
+ *             - 4 stats is empty
+ * @note       results are in mV, mA or mW of the channel
+ */
+uint8_t ina226_stats_get(ina226_handle_t *handle, const ina226_stats_t *stats, 
+                         float *min, float *max, float *mean, float *stddev)
+{
+    double lsb;
+    double m;
+    double v;
+    double x;
+    uint8_t i;
+    
+    if ((handle == NULL) || (stats == NULL))                                                     /* check handle and stats */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if (handle->inited != 1)                                                                     /* check handle initialization */
+    {
+        return 3;                                                                                /* return error */
+    }
+    if (stats->count == 0)                                                                       /* check count */
+    {
+        handle->debug_print("ina226: stats is empty.\n");                                        /* stats is empty */
+        
+        return 4;                                                                                /* return error */
+    }
+    
+    if (stats->channel == INA226_CHANNEL_SHUNT_VOLTAGE)                                          /* shunt voltage */
+    {
+        lsb = 0.0025;                                                                            /* 2.5uV */
+    }
+    else if (stats->channel == INA226_CHANNEL_BUS_VOLTAGE)                                       /* bus voltage */
+    {
+        lsb = 1.25;                                                                              /* 1.25mV */
+    }
+    else if (stats->channel == INA226_CHANNEL_CURRENT)                                           /* current */
+    {
+        lsb = handle->current_lsb * 1000.0;                                                      /* current lsb in mA */
+    }
+    else                                                                                         /* power */
+    {
+        lsb = handle->current_lsb * 25.0 * 1000.0;                                               /* power lsb in mW */
+    }
+    m = (double)stats->sum / (double)stats->count;                                               /* shifted mean */
+    v = 0.0;                                                                                     /* init 0 */
+    if (stats->count > 1)                                                                        /* check count */
+    {
+        v = ((double)stats->sumsq - (double)stats->sum * m) / (double)(stats->count - 1);        /* sample variance */
+    }
+    x = (v > 1.0) ? v : 1.0;                                                                     /* newton start point */
+    for (i = 0; (v > 0.0) && (i < 32); i++)                                                      /* square root */
+    {
+        x = 0.5 * (x + v / x);                                                                   /* newton step */
+    }
+    *min = (float)((double)stats->min * lsb);                                                    /* convert the min */
+    *max = (float)((double)stats->max * lsb);                                                    /* convert the max */
+    *mean = (float)(((double)stats->offset + m) * lsb);                                          /* convert the mean */
+    *stddev = (v > 0.0) ? (float)(x * lsb) : 0.0f;                                               /* convert the stddev */
+    
+    return 0;                                                                                    /* success return 0 */
+}
+
+/**
+ * @brief     scale a channel sum
+ * @param[in] sum channel sum
+ * @param[in] div sum divisor
+ * @param[in] num scale numerator
+ * @param[in] den scale denominator
+ * @return    sum / div * num / den
+ * @note      div must not exceed 2^32
+ */
+static int64_t a_ina226_decimator_scale(int64_t sum, int64_t div, int64_t num, int64_t den)
+{
+    int64_t q;
+    int64_t r;
+    
+    q = sum / div;                                              /* get the quotient */
+    r = sum % div;                                              /* get the remainder */
+    
+    return (q * num + (r * num) / div) / den;                   /* scale without overflow */
+}
+
+/**
+ * @brief     output the decimator sums
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @param[in] *sum pointer to the channel sums
+ * @param[in] div sum divisor
+ * @param[in] *in pointer to the last input sample structure
+ * @param[in] *out pointer to an output sample structure
+ * @note      none
+ */
+static void a_ina226_decimator_output(ina226_handle_t *handle, const int64_t *sum, int64_t div, 
+                                      const ina226_sample_t *in, ina226_sample_t *out)
+{
+    int64_t raw[4];
+    uint8_t c;
+    
+    for (c = 0; c < 4; c++)                                                                      /* all channels */
+    {
+        raw[c] = (sum[c] >= 0) ? ((sum[c] + div / 2) / div) : ((sum[c] - div / 2) / div);        /* round the mean */
+    }
+    out->timestamp_us = in->timestamp_us;                                                        /* set the timestamp */
+    out->shunt_voltage_raw = (int16_t)raw[0];                                                    /* set the shunt voltage raw */
+    out->bus_voltage_raw = (uint16_t)raw[1];                                                     /* set the bus voltage raw */
+    out->current_raw = (int16_t)raw[2];                                                          /* set the current raw */
+    out->power_raw = (uint16_t)raw[3];                                                           /* set the power raw */
+    out->mixed = 0;                                                                              /* averaged */
+    out->shunt_voltage_mV = (float)((double)sum[0] / (double)div / 400.0);                       /* convert shunt voltage */
+    out->bus_voltage_mV = (float)((double)sum[1] / (double)div * 1.25);                          /* convert bus voltage */
+    out->current_mA = (float)((double)sum[2] / (double)div * 
+                              handle->current_lsb * 1000.0);                                     /* convert current */
+    out->power_mW = (float)((double)sum[3] / (double)div * 
+                            handle->current_lsb * 25.0 * 1000.0);                                /* convert power */
+    out->shunt_voltage_uV = (int32_t)a_ina226_decimator_scale(sum[0], div, 5, 2);                /* convert shunt voltage in uV */
+    out->bus_voltage_uV = (int32_t)a_ina226_decimator_scale(sum[1], div, 1250, 1);               /* convert bus voltage in uV */
+    out->current_uA = (int32_t)a_ina226_decimator_scale(sum[2], div, 
+                                                        handle->current_lsb_na, 1000);           /* convert current in uA */
+    out->power_uW = a_ina226_decimator_scale(sum[3], div, 
+                                             (int64_t)handle->current_lsb_na * 25, 1000);        /* convert power in uW */
+}
+
+/**
+ * @brief     initialize the decimator
+ * @param[in] *dec pointer to an ina226 decimator structure
+ * @param[in] type decimator type
+ * @param[in] ratio decimation ratio or moving average window
+ * @param[in] order cic order
+ * @param[in] *history pointer to a history buffer of ratio * 4 items
+ * @return    status code
+ *            - 0 success
+ *            - 2 dec is NULL
+ *            - 4 ratio or order is invalid
+ *            - 5 history is NULL
+ * @note      history is only used by the moving average and can be NULL otherwise,
+ *            order is only used by the cic and the filter gain must not exceed 2^32
+ */
+uint8_t ina226_decimator_init(ina226_decimator_t *dec, ina226_decimator_type_t type, 
+                              uint32_t ratio, uint8_t order, uint16_t *history)
+{
+    uint8_t i;
+    uint64_t gain;
+    
+    if (dec == NULL)                                                             /* check dec */
+    {
+        return 2;                                                                /* return error */
+    }
+    if (ratio == 0)                                                              /* check ratio */
+    {
+        return 4;                                                                /* return error */
+    }
+    
+    gain = ratio;                                                                /* boxcar and moving average gain */
+    if (type == INA226_DECIMATOR_CIC)                                            /* cic */
+    {
+        if ((order == 0) || (order > INA226_DECIMATOR_MAX_ORDER))                /* check order */
+        {
+            return 4;                                                            /* return error */
+        }
+        for (i = 1; i < order; i++)                                              /* ratio ^ order */
+        {
+            gain *= ratio;                                                       /* multiply the ratio */
+            if (gain > 0x100000000ULL)                                           /* check gain */
+            {
+                return 4;                                                        /* return error */
+            }
+        }
+    }
+    else if (type == INA226_DECIMATOR_MOVING_AVERAGE)                            /* moving average */
+    {
+        if (history == NULL)                                                     /* check history */
+        {
+            return 5;                                                            /* return error */
+        }
+    }
+    else if (type != INA226_DECIMATOR_BOXCAR)                                    /* check type */
+    {
+        return 4;                                                                /* return error */
+    }
+    
+    memset(dec, 0, sizeof(ina226_decimator_t));                                  /* clear the decimator */
+    dec->type = type;                                                            /* set the type */
+    dec->ratio = ratio;                                                          /* set the ratio */
+    dec->order = order;                                                          /* set the order */
+    dec->gain = gain;                                                            /* set the gain */
+    dec->history = history;                                                      /* set the history */
+    
+    return 0;                                                                    /* success return 0 */
+}
+
+/**
+ * @brief     reset the decimator state
+ * @param[in] *dec pointer to an ina226 decimator structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 dec is NULL
+ * @note      none
+ */
+uint8_t ina226_decimator_reset(ina226_decimator_t *dec)
+{
+    if (dec == NULL)                                                             /* check dec */
+    {
+        return 2;                                                                /* return error */
+    }
+    
+    dec->count = 0;                                                              /* clear the count */
+    dec->settle = 0;                                                             /* clear the settle counter */
+    memset(dec->sum, 0, sizeof(dec->sum));                                       /* clear the sums */
+    memset(dec->integrator, 0, sizeof(dec->integrator));                         /* clear the integrators */
+    memset(dec->comb, 0, sizeof(dec->comb));                                     /* clear the combs */
+    
+    return 0;                                                                    /* success return 0 */
+}
+
+/**
+ * @brief      feed a sample into the decimator
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[in]  *dec pointer to an ina226 decimator structure
+ * @param[in]  *in pointer to an input sample structure
+ * @param[out] *out pointer to an output sample structure
+ * @param[out] *ready pointer to an output ready buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle, dec, in, out or ready is NULL
+ *             - 3 handle is not initialized
+ * @note       out is only written when ready is true,
+ *             the raw fields are rounded and the converted fields keep the extra resolution
+ */
+uint8_t ina226_decimator_update(ina226_handle_t *handle, ina226_decimator_t *dec, 
+                                const ina226_sample_t *in, ina226_sample_t *out, ina226_bool_t *ready)
+{
+    uint8_t c;
+    uint8_t k;
+    uint16_t *slot;
+    int64_t x[4];
+    int64_t y[4];
+    uint64_t t;
+    uint64_t v;
+    
+    if ((handle == NULL) || (dec == NULL) || (in == NULL) || 
+        (out == NULL) || (ready == NULL))                                        /* check the pointers */
+    {
+        return 2;                                                                /* return error */
+    }
+    if (handle->inited != 1)                                                     /* check handle initialization */
+    {
+        return 3;                                                                /* return error */
+    }
+    
+    *ready = INA226_BOOL_FALSE;                                                  /* no output */
+    x[0] = in->shunt_voltage_raw;                                                /* get the shunt voltage */
+    x[1] = in->bus_voltage_raw;                                                  /* get the bus voltage */
+    x[2] = in->current_raw;                                                      /* get the current */
+    x[3] = in->power_raw;                                                        /* get the power */
+    if (dec->type == INA226_DECIMATOR_BOXCAR)                                    /* boxcar */
+    {
+        for (c = 0; c < 4; c++)                                                  /* all channels */
+        {
+            dec->sum[c] += x[c];                                                 /* add to the sum */
+        }
+        dec->count++;                                                            /* count++ */
+        if (dec->count >= dec->ratio)                                            /* check the ratio */
+        {
+            a_ina226_decimator_output(handle, dec->sum, (int64_t)dec->gain, 
+                                      in, out);                                  /* output */
+            memset(dec->sum, 0, sizeof(dec->sum));                               /* clear the sums */
+            dec->count = 0;                                                      /* clear the count */
+            *ready = INA226_BOOL_TRUE;                                           /* output ready */
+        }
+    }
+    else if (dec->type == INA226_DECIMATOR_MOVING_AVERAGE)                       /* moving average */
+    {
+        slot = &dec->history[(dec->count % dec->ratio) * 4];                     /* get the oldest slot */
+        for (c = 0; c < 4; c++)                                                  /* all channels */
+        {
+            if (dec->count >= dec->ratio)                                        /* window is full */
+            {
+                dec->sum[c] -= ((c & 1) == 0) ? (int64_t)((int16_t)slot[c]) : 
+                                                (int64_t)slot[c];                /* remove the oldest */
+            }
+            slot[c] = (uint16_t)x[c];                                            /* save the newest */
+            dec->sum[c] += x[c];                                                 /* add the newest */
+        }
+        dec->count++;                                                            /* count++ */
+        if (dec->count >= 2 * dec->ratio)                                        /* keep the index bounded */
+        {
+            dec->count -= dec->ratio;                                            /* wrap */
+        }
+        if (dec->count >= dec->ratio)                                            /* check the window */
+        {
+            a_ina226_decimator_output(handle, dec->sum, (int64_t)dec->gain, 
+                                      in, out);                                  /* output */
+            *ready = INA226_BOOL_TRUE;                                           /* output ready */
+        }
+    }
+    else                                                                         /* cic */
+    {
+        for (c = 0; c < 4; c++)                                                  /* all channels */
+        {
+            v = (uint64_t)x[c];                                                  /* integrator input */
+            for (k = 0; k < dec->order; k++)                                     /* integrator stages */
+            {
+                dec->integrator[c][k] += v;                                      /* integrate */
+                v = dec->integrator[c][k];                                       /* next stage input */
+            }
+        }
+        dec->count++;                                                            /* count++ */
+        if (dec->count >= dec->ratio)                                            /* check the ratio */
+        {
+            dec->count = 0;                                                      /* clear the count */
+            for (c = 0; c < 4; c++)                                              /* all channels */
+            {
+                v = dec->integrator[c][dec->order - 1];                          /* comb input */
+                for (k = 0; k < dec->order; k++)                                 /* comb stages */
+                {
+                    t = v;                                                       /* save the input */
+                    v = v - dec->comb[c][k];                                     /* differentiate */
+                    dec->comb[c][k] = t;                                         /* delay */
+                }
+                y[c] = (int64_t)v;                                               /* get the output */
+            }
+            if ((dec->settle + 1) < dec->order)                                  /* check the settle counter */
+            {
+                dec->settle++;                                                   /* drop the transient output */
+            }
+            else
+            {
+                a_ina226_decimator_output(handle, y, (int64_t)dec->gain, 
+                                          in, out);                              /* output */
+                *ready = INA226_BOOL_TRUE;                                       /* output ready */
+            }
+        }
+    }
+    
+    return 0;                                                                    /* success return 0 */
+}
+
+/**
+ * @brief      compile an alert rule
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[out] *rule pointer to an ina226 alert rule structure
+ * @param[in]  channel watched channel
+ * @param[in]  direction alert direction
+ * @param[in]  set threshold that raises the alert in mV, mA or mW
+ * @param[in]  clear threshold that releases the alert in mV, mA or mW
+ * @param[in]  duration_us minimum time beyond the set threshold
+ * @return     status code
+ *             - 0 success
+ *             - 1 compile failed
+ *             - 2 handle or rule is NULL
+ *             - 3 handle is not initialized
+ *             - 4 clear threshold is on the wrong side of the set threshold
+ * @note       thresholds are converted to raw register units here,
+ *             so the calibration must not change afterwards,
+ *             a threshold out of the register range or a current and power
+ *             threshold without a calibrated current lsb fails to compile
+ */
+uint8_t ina226_alert_rule_init(ina226_handle_t *handle, ina226_alert_rule_t *rule, ina226_channel_t channel, 
+                               ina226_alert_direction_t direction, float set, float clear, uint32_t duration_us)
+{
+    uint8_t res;
+    uint16_t set_reg = 0;
+    uint16_t clear_reg = 0;
+    
+    if ((handle == NULL) || (rule == NULL))                                          /* check handle and rule */
+    {
+        return 2;                                                                    /* return error */
+    }
+    if (handle->inited != 1)                                                         /* check handle initialization */
+    {
+        return 3;                                                                    /* return error */
+    }
+    
+    if (((direction == INA226_ALERT_DIRECTION_OVER) && (clear > set)) || 
+        ((direction == INA226_ALERT_DIRECTION_UNDER) && (clear < set)))              /* check hysteresis */
+    {
+        handle->debug_print("ina226: clear threshold is invalid.\n");                /* clear threshold is invalid */
+        
+        return 4;                                                                    /* return error */
+    }
+    if ((a_ina226_alert_threshold_check(handle, channel, set) != 0) || 
+        (a_ina226_alert_threshold_check(handle, channel, clear) != 0))               /* check the thresholds */
+    {
+        handle->debug_print("ina226: threshold is out of range.\n");                 /* threshold is out of range */
+        
+        return 1;                                                                    /* return error */
+    }
+    if (channel == INA226_CHANNEL_SHUNT_VOLTAGE)                                     /* shunt voltage */
+    {
+        res = ina226_shunt_voltage_convert_to_register(handle, set, &set_reg);       /* convert set */
+        res |= ina226_shunt_voltage_convert_to_register(handle, clear, &clear_reg);  /* convert clear */
+        rule->set_raw = (int16_t)set_reg;                                            /* set the set threshold */
+        rule->clear_raw = (int16_t)clear_reg;                                        /* set the clear threshold */
+    }
+    else if (channel == INA226_CHANNEL_BUS_VOLTAGE)                                  /* bus voltage */
+    {
+        res = ina226_bus_voltage_convert_to_register(handle, set, &set_reg);         /* convert set */
+        res |= ina226_bus_voltage_convert_to_register(handle, clear, &clear_reg);    /* convert clear */
+        rule->set_raw = set_reg;                                                     /* set the set threshold */
+        rule->clear_raw = clear_reg;                                                 /* set the clear threshold */
+    }
+    else if (channel == INA226_CHANNEL_CURRENT)                                      /* current */
+    {
+        res = ina226_current_convert_to_register(handle, set, &set_reg);             /* convert set */
+        res |= ina226_current_convert_to_register(handle, clear, &clear_reg);        /* convert clear */
+        rule->set_raw = (int16_t)set_reg;                                            /* set the set threshold */
+        rule->clear_raw = (int16_t)clear_reg;                                        /* set the clear threshold */
+    }
+    else                                                                             /* power */
+    {
+        res = ina226_power_convert_to_register(handle, set, &set_reg);               /* convert set */
+        res |= ina226_power_convert_to_register(handle, clear, &clear_reg);          /* convert clear */
+        rule->set_raw = set_reg;                                                     /* set the set threshold */
+        rule->clear_raw = clear_reg;                                                 /* set the clear threshold */
+    }
+    if (res != 0)                                                                    /* check result */
+    {
+        handle->debug_print("ina226: convert to register failed.\n");                /* convert to register failed */
+        
+        return 1;                                                                    /* return error */
+    }
+    rule->channel = channel;                                                         /* set the channel */
+    rule->direction = direction;                                                     /* set the direction */
+    rule->duration_us = duration_us;                                                 /* set the duration */
+    rule->since_us = 0;                                                              /* clear the start time */
+    rule->pending = 0;                                                               /* clear the pending flag */
+    rule->active = 0;                                                                /* clear the active flag */
+    
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief      check a sample against the alert rules
+ * @param[in]  *rule pointer to an ina226 alert rule array
+ * @param[in]  num rule number
+ * @param[in]  *sample pointer to a timestamped sample structure
+ * @param[out] *active pointer to an active rule mask buffer
+ * @param[out] *changed pointer to a changed rule mask buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 rule, sample, active or changed is NULL
+ *             - 4 num is over 32
+ * @note       only integer compares are done per sample,
+ *             without sample timestamps a rule with a duration never raises
+ */
+uint8_t ina226_alert_rule_check(ina226_alert_rule_t *rule, uint8_t num, const ina226_sample_t *sample, 
+                                uint32_t *active, uint32_t *changed)
+{
+    uint8_t i;
+    uint8_t trip;
+    uint8_t release;
+    int32_t raw;
+    
+    if ((rule == NULL) || (sample == NULL) || (active == NULL) || (changed == NULL))        /* check the pointers */
+    {
+        return 2;                                                                           /* return error */
+    }
+    if (num > 32)                                                                           /* check num */
+    {
+        return 4;                                                                           /* return error */
+    }
+    
+    *active = 0;                                                                            /* clear the active mask */
+    *changed = 0;                                                                           /* clear the changed mask */
+    for (i = 0; i < num; i++)                                                               /* check all rules */
+    {
+        raw = a_ina226_sample_raw(sample, rule[i].channel);                                 /* get the channel raw */
+        if (rule[i].direction == INA226_ALERT_DIRECTION_OVER)                               /* over */
+        {
+            trip = (raw >= rule[i].set_raw) ? 1 : 0;                                        /* check set */
+            release = (raw <= rule[i].clear_raw) ? 1 : 0;                                   /* check clear */
+        }
+        else                                                                                /* under */
+        {
+            trip = (raw <= rule[i].set_raw) ? 1 : 0;                                        /* check set */
+            release = (raw >= rule[i].clear_raw) ? 1 : 0;                                   /* check clear */
+        }
+        if (rule[i].active == 0)                                                            /* not active */
+        {
+            if (trip == 0)                                                                  /* below the set threshold */
+            {
+                rule[i].pending = 0;                                                        /* clear the pending flag */
+            }
+            else
+            {
+                if (rule[i].pending == 0)                                                   /* first tripped sample */
+                {
+                    rule[i].pending = 1;                                                    /* set the pending flag */
+                    rule[i].since_us = sample->timestamp_us;                                /* save the start time */
+                }
+                if ((sample->timestamp_us - rule[i].since_us) >= rule[i].duration_us)       /* check the duration */
+                {
+                    rule[i].pending = 0;                                                    /* clear the pending flag */
+                    rule[i].active = 1;                                                     /* raise the alert */
+                    *changed |= (uint32_t)1 << i;                                           /* set changed */
+                }
+            }
+        }
+        else if (release != 0)                                                              /* active and released */
+        {
+            rule[i].active = 0;                                                             /* release the alert */
+            *changed |= (uint32_t)1 << i;                                                   /* set changed */
+        }
+        if (rule[i].active != 0)                                                            /* check active */
+        {
+            *active |= (uint32_t)1 << i;                                                    /* set active */
+        }
+    }
+    
+    return 0;                                                                               /* success return 0 */
 }
 
 /**
@@ -63,6 +63,64 @@ extern "C"{
     #define INA226_READ_TIMEOUT    1000        /**< 1000ms */
 #endif
 
+/**
+ * @brief ina226 read all retry definition
+ */
+#ifndef INA226_READ_ALL_RETRY
+    #define INA226_READ_ALL_RETRY    3        /**< 3 times */
+#endif
+
+/**
+ * @brief ina226 bus max device definition
+ */
+#ifndef INA226_BUS_MAX_DEVICE
+    #define INA226_BUS_MAX_DEVICE    16        /**< 16 devices */
+#endif
+
+/**
+ * @brief ina226 read batch max definition
+ */
+#ifndef INA226_READ_BATCH_MAX
+    #define INA226_READ_BATCH_MAX    21        /**< 21 register reads, 42 i2c messages, at least 7 */
+#endif
+
+/**
+ * @brief ina226 enable stats definition
+ */
+#ifndef INA226_ENABLE_STATS
+    #define INA226_ENABLE_STATS    0        /**< disabled */
+#endif
+
+/**
+ * @brief ina226 decimator max order definition
+ */
+#ifndef INA226_DECIMATOR_MAX_ORDER
+    #define INA226_DECIMATOR_MAX_ORDER    4        /**< 4 stages */
+#endif
+
+/**
+ * @brief ina226 latest read retry definition
+ */
+#ifndef INA226_LATEST_RETRY
+    #define INA226_LATEST_RETRY    1000        /**< 1000 times */
+#endif
+
+/**
+ * @brief ina226 memory barrier definition
+ */
+#ifndef INA226_MEMORY_BARRIER
+    #if defined(__GNUC__) || defined(__clang__)
+        #define INA226_MEMORY_BARRIER()    __sync_synchronize()        /**< full barrier */
+    #elif defined(__CC_ARM)
+        #define INA226_MEMORY_BARRIER()    __dmb(0xF)                  /**< armcc full barrier */
+    #elif defined(__ICCARM__)
+        #include <intrinsics.h>
+        #define INA226_MEMORY_BARRIER()    __DMB()                     /**< iar full barrier */
+    #else
+        #error "ina226: define INA226_MEMORY_BARRIER for this compiler."
+    #endif
+#endif
+
 /**
  * @brief ina226 address enumeration definition
  */
@@ -161,6 +219,22 @@ typedef enum
     INA226_MASK_POWER_OVER_LIMIT            = 11,        /**< power over limit */
 } ina226_mask_t;
 
+/**
+ * @brief ina226 flag enumeration definition
+ */
+typedef enum
+{
+    INA226_FLAG_SHUNT_VOLTAGE_OVER_VOLTAGE  = (1 << 15),        /**< shunt voltage over voltage function */
+    INA226_FLAG_SHUNT_VOLTAGE_UNDER_VOLTAGE = (1 << 14),        /**< shunt voltage under voltage function */
+    INA226_FLAG_BUS_VOLTAGE_OVER_VOLTAGE    = (1 << 13),        /**< bus voltage over voltage function */
+    INA226_FLAG_BUS_VOLTAGE_UNDER_VOLTAGE   = (1 << 12),        /**< bus voltage under voltage function */
+    INA226_FLAG_POWER_OVER_LIMIT            = (1 << 11),        /**< power over limit function */
+    INA226_FLAG_CONVERSION_READY_ENABLE     = (1 << 10),        /**< conversion ready alert enable */
+    INA226_FLAG_ALERT_FUNCTION              = (1 << 4),         /**< alert function flag */
+    INA226_FLAG_CONVERSION_READY            = (1 << 3),         /**< conversion ready flag */
+    INA226_FLAG_MATH_OVERFLOW               = (1 << 2),         /**< math overflow flag */
+} ina226_flag_t;
+
 /**
  * @brief ina226 alert polarity enumeration definition
  */
@@ -170,6 +244,85 @@ typedef enum
     INA226_ALERT_POLARITY_INVERTED = 1,        /**< active high open collector */
 } ina226_alert_polarity_t;
 
+/**
+ * @brief ina226 channel enumeration definition
+ */
+typedef enum
+{
+    INA226_CHANNEL_SHUNT_VOLTAGE = 0,        /**< shunt voltage in mV */
+    INA226_CHANNEL_BUS_VOLTAGE   = 1,        /**< bus voltage in mV */
+    INA226_CHANNEL_CURRENT       = 2,        /**< current in mA */
+    INA226_CHANNEL_POWER         = 3,        /**< power in mW */
+} ina226_channel_t;
+
+/**
+ * @brief ina226 decimator type enumeration definition
+ */
+typedef enum
+{
+    INA226_DECIMATOR_BOXCAR         = 0,        /**< mean of ratio samples, one output per ratio samples */
+    INA226_DECIMATOR_MOVING_AVERAGE = 1,        /**< mean of the last ratio samples, one output per sample */
+    INA226_DECIMATOR_CIC            = 2,        /**< cic filter, one output per ratio samples */
+} ina226_decimator_type_t;
+
+/**
+ * @brief ina226 alert direction enumeration definition
+ */
+typedef enum
+{
+    INA226_ALERT_DIRECTION_OVER  = 0,        /**< raise above the set threshold */
+    INA226_ALERT_DIRECTION_UNDER = 1,        /**< raise below the set threshold */
+} ina226_alert_direction_t;
+
+/**
+ * @brief ina226 config structure definition
+ */
+typedef struct ina226_config_s
+{
+    ina226_avg_t avg;                                                /**< average mode */
+    ina226_conversion_time_t bus_voltage_conversion_time;            /**< bus voltage conversion time */
+    ina226_conversion_time_t shunt_voltage_conversion_time;          /**< shunt voltage conversion time */
+    ina226_mode_t mode;                                              /**< chip mode */
+    uint16_t calibration;                                            /**< calibration data */
+} ina226_config_t;
+
+/**
+ * @brief ina226 sample structure definition
+ */
+typedef struct ina226_sample_s
+{
+    uint64_t timestamp_us;            /**< sample timestamp in us */
+    int16_t shunt_voltage_raw;        /**< shunt voltage raw data */
+    float shunt_voltage_mV;           /**< shunt voltage in mV, see ina226_sample_convert_to_data */
+    int32_t shunt_voltage_uV;         /**< shunt voltage in uV */
+    uint16_t bus_voltage_raw;         /**< bus voltage raw data */
+    float bus_voltage_mV;             /**< bus voltage in mV, see ina226_sample_convert_to_data */
+    int32_t bus_voltage_uV;           /**< bus voltage in uV */
+    int16_t current_raw;              /**< current raw data */
+    float current_mA;                 /**< current in mA, see ina226_sample_convert_to_data */
+    int32_t current_uA;               /**< current in uA */
+    uint16_t power_raw;               /**< power raw data */
+    float power_mW;                   /**< power in mW, see ina226_sample_convert_to_data */
+    int64_t power_uW;                 /**< power in uW */
+    uint8_t mixed;                    /**< 1 if the registers may mix two conversions */
+} ina226_sample_t;
+
+/**
+ * @brief ina226 driver stats structure definition
+ */
+typedef struct ina226_driver_stats_s
+{
+    uint32_t read[10];              /**< reads of registers 0x00 - 0x07, 0xFE and the others */
+    uint32_t write[10];             /**< writes of registers 0x00 - 0x07, 0xFE and the others */
+    uint32_t read_error;            /**< failed reads */
+    uint32_t write_error;           /**< failed writes */
+    uint32_t timeout;               /**< conversion ready timeouts */
+    uint32_t retry;                 /**< read all retries */
+    uint32_t mixed;                 /**< read all samples that may mix two conversions */
+    uint32_t overflow;              /**< math overflow flags seen */
+    uint32_t latency[32];           /**< transfer time histogram, bin n counts [2^n, 2^(n + 1)) us */
+} ina226_driver_stats_t;
+
 /**
  * @brief ina226 handle structure definition
  */
@@ -180,13 +333,39 @@ typedef struct ina226_handle_s
     uint8_t (*iic_deinit)(void);                                                        /**< point to an iic_deinit function address */
     uint8_t (*iic_read)(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);         /**< point to an iic_read function address */
     uint8_t (*iic_write)(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);        /**< point to an iic_write function address */
+    uint8_t (*iic_read_cmd)(uint8_t addr, uint8_t *buf, uint16_t len);                  /**< point to an iic_read_cmd function address */
+    uint8_t (*iic_read_batch)(uint8_t *addr, uint8_t *reg, uint8_t *buf, uint8_t num);  /**< point to an iic_read_batch function address */
     void (*delay_ms)(uint32_t ms);                                                      /**< point to a delay_ms function address */
+    void (*delay_us)(uint32_t us);                                                      /**< point to a delay_us function address */
     void (*debug_print)(const char *const fmt, ...);                                    /**< point to a debug_print function address */
     void (*receive_callback)(uint8_t type);                                             /**< point to a receive_callback function address */
+    void (*receive_callback_ex)(struct ina226_handle_s *handle, 
+                                uint8_t type, void *user_data);                         /**< point to a receive_callback_ex function address */
+    void *user_data;                                                                    /**< user context */
+    void (*flags_callback)(struct ina226_handle_s *handle, 
+                           uint16_t flags, void *user_data);                            /**< point to a flags_callback function address */
+    uint8_t (*wait_ready)(uint32_t ms);                                                 /**< point to a wait_ready function address */
+    uint64_t (*get_time_us)(void);                                                      /**< point to a get_time_us function address */
+    uint64_t irq_timestamp_us;                                                          /**< alert edge timestamp in us */
+    volatile uint32_t irq_seq;                                                          /**< alert edge timestamp sequence */
+    uint32_t irq_used;                                                                  /**< consumed alert edge sequence */
     double r;                                                                           /**< resistance */
     double current_lsb;                                                                 /**< current lsb */
+    uint32_t current_lsb_na;                                                            /**< current lsb in nA */
+    uint16_t reg_conf;                                                                  /**< conf register shadow */
+    uint16_t reg_mask;                                                                  /**< mask register shadow */
+    uint16_t reg_calibration;                                                           /**< calibration register shadow */
+    uint16_t reg_alert_limit;                                                           /**< alert limit register shadow */
+    uint16_t flags;                                                                     /**< sticky mask flags */
+    uint8_t pointer;                                                                    /**< register pointer */
+    uint8_t pointer_valid;                                                              /**< register pointer valid flag */
+    uint8_t cache;                                                                      /**< register cache flag */
     uint8_t inited;                                                                     /**< inited flag */
     uint8_t trigger;                                                                    /**< trigger flag */
+    uint8_t finished;                                                                   /**< finished conversion flag */
+#if (INA226_ENABLE_STATS != 0)
+    ina226_driver_stats_t stats;                                                        /**< driver stats */
+#endif
 } ina226_handle_t;
 
 /**
@@ -205,6 +384,127 @@ typedef struct ina226_info_s
     uint32_t driver_version;           /**< driver version */
 } ina226_info_t;
 
+/**
+ * @brief ina226 scan structure definition
+ */
+typedef struct ina226_scan_s
+{
+    uint16_t found;                      /**< found address mask */
+    uint16_t other;                      /**< other ti part address mask */
+    uint8_t num;                         /**< found device number */
+    ina226_address_t addr[16];           /**< found device addresses */
+    uint16_t device_id[16];              /**< found device ids */
+    uint8_t die_revision_id[16];         /**< found die revision ids */
+} ina226_scan_t;
+
+/**
+ * @brief ina226 bus frame structure definition
+ */
+typedef struct ina226_bus_frame_s
+{
+    uint64_t timestamp_us;                                /**< sweep start timestamp in us */
+    uint32_t sequence;                                    /**< sweep sequence */
+    uint32_t valid;                                       /**< updated device mask */
+    uint32_t error;                                       /**< failed device mask */
+    ina226_sample_t sample[INA226_BUS_MAX_DEVICE];        /**< device samples */
+} ina226_bus_frame_t;
+
+/**
+ * @brief ina226 bus structure definition
+ */
+typedef struct ina226_bus_s
+{
+    ina226_handle_t device[INA226_BUS_MAX_DEVICE];        /**< device handles */
+    uint8_t divider[INA226_BUS_MAX_DEVICE];               /**< device rate dividers */
+    uint8_t num;                                          /**< device number */
+    uint32_t sequence;                                    /**< sweep sequence */
+    uint64_t (*get_time_us)(void);                        /**< point to a get_time_us function address */
+} ina226_bus_t;
+
+/**
+ * @brief ina226 ring structure definition
+ */
+typedef struct ina226_ring_s
+{
+    ina226_sample_t *buf;             /**< sample storage */
+    uint32_t size;                    /**< storage size */
+    uint32_t mask;                    /**< index mask */
+    volatile uint32_t head;           /**< producer index */
+    volatile uint32_t tail;           /**< consumer index */
+    volatile uint32_t overrun;        /**< dropped sample counter */
+} ina226_ring_t;
+
+/**
+ * @brief ina226 latest structure definition
+ */
+typedef struct ina226_latest_s
+{
+    volatile uint32_t seq;            /**< sequence, odd while written */
+    uint16_t flags;                   /**< sticky flags */
+    uint16_t reserved;                /**< reserved */
+    ina226_sample_t sample;           /**< latest sample */
+} ina226_latest_t;
+
+/**
+ * @brief ina226 energy structure definition
+ */
+typedef struct ina226_energy_s
+{
+    int64_t charge_raw;               /**< sum of current raw pairs multiplied by us */
+    uint64_t energy_raw;              /**< sum of power raw pairs multiplied by us */
+    uint64_t elapsed_us;              /**< integrated time in us */
+    uint64_t last_us;                 /**< last sample timestamp in us */
+    int16_t last_current_raw;         /**< last current raw data */
+    uint16_t last_power_raw;          /**< last power raw data */
+    uint32_t count;                   /**< integrated sample counter */
+} ina226_energy_t;
+
+/**
+ * @brief ina226 stats structure definition
+ */
+typedef struct ina226_stats_s
+{
+    ina226_channel_t channel;         /**< channel */
+    int32_t offset;                   /**< first raw data */
+    int32_t min;                      /**< min raw data */
+    int32_t max;                      /**< max raw data */
+    uint32_t count;                   /**< sample counter */
+    int64_t sum;                      /**< sum of raw data minus offset */
+    uint64_t sumsq;                   /**< sum of squared raw data minus offset */
+} ina226_stats_t;
+
+/**
+ * @brief ina226 decimator structure definition
+ */
+typedef struct ina226_decimator_s
+{
+    ina226_decimator_type_t type;                                  /**< decimator type */
+    uint32_t ratio;                                                /**< decimation ratio */
+    uint8_t order;                                                 /**< cic order */
+    uint8_t settle;                                                /**< cic settle counter */
+    uint32_t count;                                                /**< input counter */
+    uint64_t gain;                                                 /**< filter gain */
+    uint16_t *history;                                             /**< moving average history */
+    int64_t sum[4];                                                /**< channel sums */
+    uint64_t integrator[4][INA226_DECIMATOR_MAX_ORDER];            /**< cic integrators */
+    uint64_t comb[4][INA226_DECIMATOR_MAX_ORDER];                  /**< cic comb delays */
+} ina226_decimator_t;
+
+/**
+ * @brief ina226 alert rule structure definition
+ */
+typedef struct ina226_alert_rule_s
+{
+    ina226_channel_t channel;                  /**< watched channel */
+    ina226_alert_direction_t direction;        /**< alert direction */
+    int32_t set_raw;                           /**< set threshold raw data */
+    int32_t clear_raw;                         /**< clear threshold raw data */
+    uint32_t duration_us;                      /**< minimum duration in us */
+    uint64_t since_us;                         /**< pending start time in us */
+    uint8_t pending;                           /**< pending flag */
+    uint8_t active;                            /**< active flag */
+} ina226_alert_rule_t;
+
 /**
  * @}
  */
@@ -256,6 +556,22 @@ typedef struct ina226_info_s
  */
 #define DRIVER_INA226_LINK_IIC_WRITE(HANDLE, FUC)         (HANDLE)->iic_write = FUC
 
+/**
+ * @brief     link iic_read_cmd function
+ * @param[in] HANDLE pointer to an ina226 handle structure
+ * @param[in] FUC pointer to an iic_read_cmd function address
+ * @note      optional, reads the register the pointer already selects without rewriting it
+ */
+#define DRIVER_INA226_LINK_IIC_READ_CMD(HANDLE, FUC)      (HANDLE)->iic_read_cmd = FUC
+
+/**
+ * @brief     link iic_read_batch function
+ * @param[in] HANDLE pointer to an ina226 handle structure
+ * @param[in] FUC pointer to an iic_read_batch function address
+ * @note      optional, reads num 2 byte registers of any devices in one bus transaction
+ */
+#define DRIVER_INA226_LINK_IIC_READ_BATCH(HANDLE, FUC)    (HANDLE)->iic_read_batch = FUC
+
 /**
  * @brief     link delay_ms function
  * @param[in] HANDLE pointer to an ina226 handle structure
@@ -264,6 +580,14 @@ typedef struct ina226_info_s
  */
 #define DRIVER_INA226_LINK_DELAY_MS(HANDLE, FUC)          (HANDLE)->delay_ms = FUC
 
+/**
+ * @brief     link delay_us function
+ * @param[in] HANDLE pointer to an ina226 handle structure
+ * @param[in] FUC pointer to a delay_us function address
+ * @note      optional, the triggered read sleeps the expected conversion time when it is linked
+ */
+#define DRIVER_INA226_LINK_DELAY_US(HANDLE, FUC)          (HANDLE)->delay_us = FUC
+
 /**
  * @brief     link debug_print function
  * @param[in] HANDLE pointer to an ina226 handle structure
@@ -280,6 +604,30 @@ typedef struct ina226_info_s
  */
 #define DRIVER_INA226_LINK_RECEIVE_CALLBACK(HANDLE, FUC)  (HANDLE)->receive_callback = FUC
 
+/**
+ * @brief     link receive_callback_ex function
+ * @param[in] HANDLE pointer to an ina226 handle structure
+ * @param[in] FUC pointer to a receive_callback_ex function address
+ * @note      it gets the handle and the user data, can replace receive_callback
+ */
+#define DRIVER_INA226_LINK_RECEIVE_CALLBACK_EX(HANDLE, FUC) (HANDLE)->receive_callback_ex = FUC
+
+/**
+ * @brief     link wait_ready function
+ * @param[in] HANDLE pointer to an ina226 handle structure
+ * @param[in] FUC pointer to a wait_ready function address
+ * @note      optional, the mask register is polled when it is not linked
+ */
+#define DRIVER_INA226_LINK_WAIT_READY(HANDLE, FUC)        (HANDLE)->wait_ready = FUC
+
+/**
+ * @brief     link get_time_us function
+ * @param[in] HANDLE pointer to an ina226 handle structure
+ * @param[in] FUC pointer to a get_time_us function address
+ * @note      optional, the sample timestamp is 0 without it
+ */
+#define DRIVER_INA226_LINK_GET_TIME_US(HANDLE, FUC)       (HANDLE)->get_time_us = FUC
+
 /**
  * @}
  */
@@ -357,6 +705,132 @@ uint8_t ina226_get_resistance(ina226_handle_t *handle, double *resistance);
  */
 uint8_t ina226_irq_handler(ina226_handle_t *handle);
 
+/**
+ * @brief     irq handler with the edge timestamp
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @param[in] timestamp_us alert edge timestamp in us
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      pass the time the edge was captured in the get_time_us time base,
+ *            callbacks can read it with ina226_get_irq_timestamp
+ */
+uint8_t ina226_irq_handler_timestamp(ina226_handle_t *handle, uint64_t timestamp_us);
+
+/**
+ * @brief     set the alert edge timestamp
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @param[in] timestamp_us alert edge timestamp in us
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      when the conversion ready alert is enabled, the next sample read takes
+ *            this timestamp instead of get_time_us and clears it, 0 means none,
+ *            it can be called from an interrupt or another thread, the reader
+ *            never sees half of the 64 bits
+ */
+uint8_t ina226_set_irq_timestamp(ina226_handle_t *handle, uint64_t timestamp_us);
+
+/**
+ * @brief      get the alert edge timestamp
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[out] *timestamp_us pointer to a timestamp buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get failed
+ *             - 2 handle or timestamp_us is NULL
+ * @note       0 means no edge is pending
+ */
+uint8_t ina226_get_irq_timestamp(ina226_handle_t *handle, uint64_t *timestamp_us);
+
+/**
+ * @brief     set the user data
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @param[in] *user_data pointer to a user context
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      it is passed to receive_callback_ex
+ */
+uint8_t ina226_set_user_data(ina226_handle_t *handle, void *user_data);
+
+/**
+ * @brief      get the user data
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[out] **user_data pointer to a user context pointer buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle or user_data is NULL
+ * @note       none
+ */
+uint8_t ina226_get_user_data(ina226_handle_t *handle, void **user_data);
+
+/**
+ * @brief      get the driver statistics
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[out] *stats pointer to an ina226 driver stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle or stats is NULL
+ *             - 4 stats is disabled
+ * @note       build with INA226_ENABLE_STATS to enable it
+ */
+uint8_t ina226_get_stats(ina226_handle_t *handle, ina226_driver_stats_t *stats);
+
+/**
+ * @brief     clear the driver statistics
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 4 stats is disabled
+ * @note      build with INA226_ENABLE_STATS to enable it
+ */
+uint8_t ina226_clear_stats(ina226_handle_t *handle);
+
+/**
+ * @brief     set the flags callback
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @param[in] *callback pointer to a flags callback function address
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      callback can be NULL to disable it,
+ *            it gets the context set by ina226_set_user_data
+ */
+uint8_t ina226_set_flags_callback(ina226_handle_t *handle, void (*callback)(ina226_handle_t *handle, uint16_t flags, void *user_data));
+
+/**
+ * @brief      irq handler with all flags
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[out] *flags pointer to a flags buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the whole mask register is passed to the flags callback in one call,
+ *             the sticky flags are merged in and cleared,
+ *             see ina226_flag_t for the bits, flags can be NULL
+ */
+uint8_t ina226_irq_handler_ex(ina226_handle_t *handle, uint16_t *flags);
+
+/**
+ * @brief      get the sticky flags
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[out] *flags pointer to a flags buffer
+ * @param[in]  clear bool value
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle or flags is NULL
+ *             - 3 handle is not initialized
+ * @note       every mask register read latches the AFF, CVRF and OVF bits here,
+ *             so flags cleared on the chip by a read are not lost, no bus traffic
+ */
+uint8_t ina226_get_flags(ina226_handle_t *handle, uint16_t *flags, ina226_bool_t clear);
+
 /**
  * @brief     initialize the chip
  * @param[in] *handle pointer to an ina226 handle structure
@@ -396,6 +870,43 @@ uint8_t ina226_deinit(ina226_handle_t *handle);
  */
 uint8_t ina226_soft_reset(ina226_handle_t *handle);
 
+/**
+ * @brief     enable or disable the register cache
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set register cache failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the cache is reloaded from the chip when enabled
+ */
+uint8_t ina226_set_register_cache(ina226_handle_t *handle, ina226_bool_t enable);
+
+/**
+ * @brief      get the register cache status
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ina226_get_register_cache(ina226_handle_t *handle, ina226_bool_t *enable);
+
+/**
+ * @brief     reload the register cache from the chip
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 resync register cache failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ina226_resync_register_cache(ina226_handle_t *handle);
+
 /**
  * @brief     set average mode
  * @param[in] *handle pointer to an ina226 handle structure
@@ -500,6 +1011,34 @@ uint8_t ina226_set_mode(ina226_handle_t *handle, ina226_mode_t mode);
  */
 uint8_t ina226_get_mode(ina226_handle_t *handle, ina226_mode_t *mode);
 
+/**
+ * @brief     set the whole configuration
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @param[in] *config pointer to a config structure
+ * @param[in] verify bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set config failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 verify failed
+ * @note      calibration and conf are written with one transaction each
+ */
+uint8_t ina226_set_config(ina226_handle_t *handle, const ina226_config_t *config, ina226_bool_t verify);
+
+/**
+ * @brief      get the whole configuration
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[out] *config pointer to a config structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 get config failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ina226_get_config(ina226_handle_t *handle, ina226_config_t *config);
+
 /**
  * @brief      read the shunt voltage
  * @param[in]  *handle pointer to an ina226 handle structure
@@ -517,57 +1056,194 @@ uint8_t ina226_get_mode(ina226_handle_t *handle, ina226_mode_t *mode);
 uint8_t ina226_read_shunt_voltage(ina226_handle_t *handle, int16_t *raw, float *mV);
 
 /**
- * @brief      read the bus voltage
+ * @brief      read the shunt voltage
  * @param[in]  *handle pointer to an ina226 handle structure
  * @param[out] *raw pointer to raw data buffer
- * @param[out] *mV pointer to converted data buffer
+ * @param[out] *uV pointer to converted data buffer
  * @return     status code
  *             - 0 success
- *             - 1 read bus voltage failed
+ *             - 1 read shunt voltage failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  *             - 4 math overflow
  *             - 5 read timeout
- * @note       none
+ * @note       integer conversion in uV
  */
-uint8_t ina226_read_bus_voltage(ina226_handle_t *handle, uint16_t *raw, float *mV);
+uint8_t ina226_read_shunt_voltage_fixed(ina226_handle_t *handle, int16_t *raw, int32_t *uV);
 
 /**
- * @brief      read the power
+ * @brief      read the bus voltage
  * @param[in]  *handle pointer to an ina226 handle structure
  * @param[out] *raw pointer to raw data buffer
- * @param[out] *mW pointer to converted data buffer
+ * @param[out] *mV pointer to converted data buffer
  * @return     status code
  *             - 0 success
- *             - 1 read power failed
+ *             - 1 read bus voltage failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  *             - 4 math overflow
  *             - 5 read timeout
  * @note       none
  */
-uint8_t ina226_read_power(ina226_handle_t *handle, uint16_t *raw, float *mW);
+uint8_t ina226_read_bus_voltage(ina226_handle_t *handle, uint16_t *raw, float *mV);
 
 /**
- * @brief      read the current
+ * @brief      read the bus voltage
  * @param[in]  *handle pointer to an ina226 handle structure
  * @param[out] *raw pointer to raw data buffer
- * @param[out] *mA pointer to converted data buffer
+ * @param[out] *uV pointer to converted data buffer
  * @return     status code
  *             - 0 success
- *             - 1 read current failed
+ *             - 1 read bus voltage failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  *             - 4 math overflow
  *             - 5 read timeout
- * @note       none
+ * @note       integer conversion in uV
  */
-uint8_t ina226_read_current(ina226_handle_t *handle, int16_t *raw, float *mA);
+uint8_t ina226_read_bus_voltage_fixed(ina226_handle_t *handle, uint16_t *raw, int32_t *uV);
 
 /**
- * @brief     set the calibration
- * @param[in] *handle pointer to an ina226 handle structure
- * @param[in] data calibration data
+ * @brief      read the power
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[out] *raw pointer to raw data buffer
+ * @param[out] *mW pointer to converted data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read power failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 math overflow
+ *             - 5 read timeout
+ * @note       none
+ */
+uint8_t ina226_read_power(ina226_handle_t *handle, uint16_t *raw, float *mW);
+
+/**
+ * @brief      read the power
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[out] *raw pointer to raw data buffer
+ * @param[out] *uW pointer to converted data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read power failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 math overflow
+ *             - 5 read timeout
+ * @note       integer conversion in uW
+ */
+uint8_t ina226_read_power_fixed(ina226_handle_t *handle, uint16_t *raw, int64_t *uW);
+
+/**
+ * @brief      read the current
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[out] *raw pointer to raw data buffer
+ * @param[out] *mA pointer to converted data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read current failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 math overflow
+ *             - 5 read timeout
+ * @note       none
+ */
+uint8_t ina226_read_current(ina226_handle_t *handle, int16_t *raw, float *mA);
+
+/**
+ * @brief      read the current
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[out] *raw pointer to raw data buffer
+ * @param[out] *uA pointer to converted data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read current failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 math overflow
+ *             - 5 read timeout
+ * @note       integer conversion in uA
+ */
+uint8_t ina226_read_current_fixed(ina226_handle_t *handle, int16_t *raw, int32_t *uA);
+
+/**
+ * @brief      read shunt voltage, bus voltage, current and power of one conversion
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[out] *sample pointer to a sample structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read all failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 math overflow
+ *             - 5 read timeout
+ * @note       the shunt voltage and current are read again after the four result registers,
+ *             the read is retried if they changed, the last read is kept with mixed set
+ *             when all INA226_READ_ALL_RETRY reads changed
+ */
+uint8_t ina226_read_all(ina226_handle_t *handle, ina226_sample_t *sample);
+
+/**
+ * @brief         convert the raw data of a sample to float
+ * @param[in]     *handle pointer to an ina226 handle structure
+ * @param[in,out] *sample pointer to a sample structure
+ * @return        status code
+ *                - 0 success
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ * @note          the sample functions only fill the raw and the integer fields,
+ *                call this once a sample is consumed in float
+ */
+uint8_t ina226_sample_convert_to_data(ina226_handle_t *handle, ina226_sample_t *sample);
+
+/**
+ * @brief     start a triggered conversion
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 start conversion failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the configured triggered mode is kept, other modes start a shunt and bus conversion
+ */
+uint8_t ina226_start_conversion(ina226_handle_t *handle);
+
+/**
+ * @brief      poll the triggered conversion
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[out] *ready pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 poll conversion failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 math overflow
+ *             - 5 no conversion is started
+ * @note       one mask read without any delay
+ */
+uint8_t ina226_poll_conversion(ina226_handle_t *handle, ina226_bool_t *ready);
+
+/**
+ * @brief      fetch the sample of a finished conversion
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[out] *sample pointer to a sample structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 fetch sample failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 conversion is not ready
+ *             - 5 no conversion is started
+ * @note       ina226_poll_conversion must report ready first,
+ *             every started conversion can be fetched once
+ */
+uint8_t ina226_fetch_sample(ina226_handle_t *handle, ina226_sample_t *sample);
+
+/**
+ * @brief     set the calibration
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @param[in] data calibration data
  * @return    status code
  *            - 0 success
  *            - 1 set calibration failed
@@ -604,6 +1280,26 @@ uint8_t ina226_get_calibration(ina226_handle_t *handle, uint16_t *data);
  */
 uint8_t ina226_calculate_calibration(ina226_handle_t *handle, uint16_t *calibration);
 
+/**
+ * @brief      calculate the calibration from the max expected current
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[in]  max_current_mA max expected current in mA
+ * @param[in]  round_lsb bool value
+ * @param[out] *calibration pointer to a calibration data buffer
+ * @param[out] *lsb_mA pointer to an effective current lsb buffer
+ * @param[out] *headroom_mA pointer to an overflow headroom buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 calculate calibration ex failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 r can't be zero
+ *             - 5 max current is invalid
+ * @note       round_lsb rounds the current lsb up to a 1, 2 or 5 decimal step
+ */
+uint8_t ina226_calculate_calibration_ex(ina226_handle_t *handle, float max_current_mA, ina226_bool_t round_lsb,
+                                        uint16_t *calibration, float *lsb_mA, float *headroom_mA);
+
 /**
  * @brief     enable or disable mask
  * @param[in] *handle pointer to an ina226 handle structure
@@ -745,6 +1441,7 @@ uint8_t ina226_get_alert_limit(ina226_handle_t *handle, uint16_t *reg);
  *             - 0 success
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
+ *             - 4 mV is out of range
  * @note       none
  */
 uint8_t ina226_shunt_voltage_convert_to_register(ina226_handle_t *handle, float mV, uint16_t *reg);
@@ -771,6 +1468,7 @@ uint8_t ina226_shunt_voltage_convert_to_data(ina226_handle_t *handle, uint16_t r
  *             - 0 success
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
+ *             - 4 mV is out of range
  * @note       none
  */
 uint8_t ina226_bus_voltage_convert_to_register(ina226_handle_t *handle, float mV, uint16_t *reg);
@@ -797,6 +1495,7 @@ uint8_t ina226_bus_voltage_convert_to_data(ina226_handle_t *handle, uint16_t reg
  *             - 0 success
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
+ *             - 4 mW is out of range
  * @note       none
  */
 uint8_t ina226_power_convert_to_register(ina226_handle_t *handle, float mW, uint16_t *reg);
@@ -814,6 +1513,33 @@ uint8_t ina226_power_convert_to_register(ina226_handle_t *handle, float mW, uint
  */
 uint8_t ina226_power_convert_to_data(ina226_handle_t *handle, uint16_t reg, float *mW);
 
+/**
+ * @brief      convert the current to the register raw data
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[in]  mA milliampere
+ * @param[out] *reg pointer to a register raw buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 mA is out of range
+ * @note       none
+ */
+uint8_t ina226_current_convert_to_register(ina226_handle_t *handle, float mA, uint16_t *reg);
+
+/**
+ * @brief      convert the register raw data to the current
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[in]  reg register raw data
+ * @param[out] *mA pointer to a milliampere buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ina226_current_convert_to_data(ina226_handle_t *handle, uint16_t reg, float *mA);
+
 /**
  * @brief      get the die id
  * @param[in]  *handle pointer to an ina226 handle structure
@@ -828,6 +1554,20 @@ uint8_t ina226_power_convert_to_data(ina226_handle_t *handle, uint16_t reg, floa
  */
 uint8_t ina226_get_die_id(ina226_handle_t *handle, uint16_t *device_id, uint8_t *die_revision_id);
 
+/**
+ * @brief      scan all ina226 addresses on the bus
+ * @param[in]  *handle pointer to a linked ina226 handle structure
+ * @param[out] *scan pointer to a scan structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 iic init failed
+ *             - 2 handle or scan is NULL
+ *             - 3 linked functions is NULL
+ * @note       the handle doesn't need to be initialized and the chips are not reset,
+ *             other ti parts sharing the manufacturer id are only set in the other mask
+ */
+uint8_t ina226_scan(ina226_handle_t *handle, ina226_scan_t *scan);
+
 /**
  * @}
  */
@@ -867,6 +1607,430 @@ uint8_t ina226_set_reg(ina226_handle_t *handle, uint8_t reg, uint16_t data);
  */
 uint8_t ina226_get_reg(ina226_handle_t *handle, uint8_t reg, uint16_t *data);
 
+/**
+ * @}
+ */
+
+/**
+ * @defgroup ina226_bus_driver ina226 bus driver function
+ * @brief    ina226 bus driver modules
+ * @ingroup  ina226_driver
+ * @{
+ */
+
+/**
+ * @brief     initialize the bus manager
+ * @param[in] *bus pointer to an ina226 bus structure
+ * @param[in] *get_time_us pointer to a get_time_us function address
+ * @return    status code
+ *            - 0 success
+ *            - 2 bus is NULL
+ * @note      get_time_us can be NULL, then the frame timestamp is 0
+ */
+uint8_t ina226_bus_init(ina226_bus_t *bus, uint64_t (*get_time_us)(void));
+
+/**
+ * @brief      add a device to the bus manager
+ * @param[in]  *bus pointer to an ina226 bus structure
+ * @param[in]  *handle pointer to a linked ina226 handle structure
+ * @param[in]  divider sweep rate divider
+ * @param[out] *index pointer to a device index buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 add device failed
+ *             - 2 bus, handle or index is NULL
+ *             - 4 bus is full
+ *             - 5 divider is invalid
+ * @note       the handle is copied into the bus and initialized there,
+ *             the caller's handle is not used afterwards
+ */
+uint8_t ina226_bus_add_device(ina226_bus_t *bus, const ina226_handle_t *handle, uint8_t divider, uint8_t *index);
+
+/**
+ * @brief      get a device handle of the bus manager
+ * @param[in]  *bus pointer to an ina226 bus structure
+ * @param[in]  index device index
+ * @param[out] **handle pointer to a device handle pointer buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 bus or handle is NULL
+ *             - 4 index is invalid
+ * @note       use it to configure the device with the basic driver functions
+ */
+uint8_t ina226_bus_get_handle(ina226_bus_t *bus, uint8_t index, ina226_handle_t **handle);
+
+/**
+ * @brief      read all scheduled devices once
+ * @param[in]  *bus pointer to an ina226 bus structure
+ * @param[out] *frame pointer to a bus frame structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 sweep failed
+ *             - 2 bus or frame is NULL
+ * @note       a device is read when the sweep sequence is a multiple of its divider,
+ *             failed devices are reported in the frame error mask
+ */
+uint8_t ina226_bus_sweep(ina226_bus_t *bus, ina226_bus_frame_t *frame);
+
+/**
+ * @brief     deinit all devices of the bus manager
+ * @param[in] *bus pointer to an ina226 bus structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ *            - 2 bus is NULL
+ * @note      none
+ */
+uint8_t ina226_bus_deinit(ina226_bus_t *bus);
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup ina226_ring_driver ina226 ring driver function
+ * @brief    ina226 ring driver modules
+ * @ingroup  ina226_driver
+ * @{
+ */
+
+/**
+ * @brief     initialize the sample ring
+ * @param[in] *ring pointer to an ina226 ring structure
+ * @param[in] *buf pointer to a sample storage buffer
+ * @param[in] size storage size
+ * @return    status code
+ *            - 0 success
+ *            - 2 ring or buf is NULL
+ *            - 4 size is not a power of 2
+ * @note      the ring holds size - 1 samples,
+ *            one producer and one consumer may use it without a lock
+ */
+uint8_t ina226_ring_init(ina226_ring_t *ring, ina226_sample_t *buf, uint32_t size);
+
+/**
+ * @brief     push a sample into the ring
+ * @param[in] *ring pointer to an ina226 ring structure
+ * @param[in] *sample pointer to a sample structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 ring or sample is NULL
+ *            - 4 ring is full
+ * @note      producer side only, a full ring drops the sample and counts an overrun
+ */
+uint8_t ina226_ring_push(ina226_ring_t *ring, const ina226_sample_t *sample);
+
+/**
+ * @brief         pop samples from the ring
+ * @param[in]     *ring pointer to an ina226 ring structure
+ * @param[out]    *sample pointer to a sample buffer
+ * @param[in,out] *len pointer to a buffer length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 2 ring, sample or len is NULL
+ * @note          consumer side only, len returns the popped sample number
+ */
+uint8_t ina226_ring_pop(ina226_ring_t *ring, ina226_sample_t *sample, uint32_t *len);
+
+/**
+ * @brief      get the sample number in the ring
+ * @param[in]  *ring pointer to an ina226 ring structure
+ * @param[out] *count pointer to a count buffer
+ * @param[out] *overrun pointer to an overrun counter buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 ring, count or overrun is NULL
+ * @note       none
+ */
+uint8_t ina226_ring_get_count(ina226_ring_t *ring, uint32_t *count, uint32_t *overrun);
+
+/**
+ * @brief     read all results and push them into the ring
+ * @param[in] *handle pointer to an ina226 handle structure
+ * @param[in] *ring pointer to an ina226 ring structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ *            - 2 handle or ring is NULL
+ *            - 3 handle is not initialized
+ *            - 4 ring is full
+ * @note      producer side only
+ */
+uint8_t ina226_read_to_ring(ina226_handle_t *handle, ina226_ring_t *ring);
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup ina226_latest_driver ina226 latest driver function
+ * @brief    ina226 latest driver modules
+ * @ingroup  ina226_driver
+ * @{
+ */
+
+/**
+ * @brief     publish the latest sample
+ * @param[in] *latest pointer to an ina226 latest structure
+ * @param[in] *sample pointer to a sample structure
+ * @param[in] flags sticky flags
+ * @return    status code
+ *            - 0 success
+ *            - 2 latest or sample is NULL
+ * @note      single writer, a zeroed structure is a valid empty slot
+ */
+uint8_t ina226_latest_publish(ina226_latest_t *latest, const ina226_sample_t *sample, uint16_t flags);
+
+/**
+ * @brief      read the latest sample
+ * @param[in]  *latest pointer to an ina226 latest structure
+ * @param[out] *sample pointer to a sample buffer
+ * @param[out] *flags pointer to a flags buffer
+ * @param[out] *seq pointer to a sequence buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 latest or sample is NULL
+ *             - 4 no sample
+ * @note       any number of readers, no lock is taken, the copy is retried while the writer
+ *             is inside, 1 is returned after INA226_LATEST_RETRY tries,
+ *             seq grows by 2 per sample and skips 0 on wrap, flags and seq can be NULL
+ */
+uint8_t ina226_latest_read(const ina226_latest_t *latest, ina226_sample_t *sample, uint16_t *flags, uint32_t *seq);
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup ina226_energy_driver ina226 energy driver function
+ * @brief    ina226 energy driver modules
+ * @ingroup  ina226_driver
+ * @{
+ */
+
+/**
+ * @brief     reset the energy accumulator
+ * @param[in] *energy pointer to an ina226 energy structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 energy is NULL
+ * @note      none
+ */
+uint8_t ina226_energy_reset(ina226_energy_t *energy);
+
+/**
+ * @brief     integrate a sample into the energy accumulator
+ * @param[in] *energy pointer to an ina226 energy structure
+ * @param[in] *sample pointer to a timestamped sample structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 energy or sample is NULL
+ *            - 4 timestamp is not increasing
+ * @note      the raw registers are integrated with the trapezoid rule in 64 bits,
+ *            the first sample after a reset only sets the start point
+ */
+uint8_t ina226_energy_update(ina226_energy_t *energy, const ina226_sample_t *sample);
+
+/**
+ * @brief      copy the energy accumulator
+ * @param[in]  *energy pointer to an ina226 energy structure
+ * @param[out] *snapshot pointer to an ina226 energy snapshot buffer
+ * @param[in]  reset bool value
+ * @return     status code
+ *             - 0 success
+ *             - 2 energy or snapshot is NULL
+ * @note       reset restarts the integration from the last sample
+ */
+uint8_t ina226_energy_snapshot(ina226_energy_t *energy, ina226_energy_t *snapshot, ina226_bool_t reset);
+
+/**
+ * @brief      get the accumulated charge and energy
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[in]  *energy pointer to an ina226 energy structure
+ * @param[out] *charge_mC pointer to a charge buffer
+ * @param[out] *energy_mJ pointer to an energy buffer
+ * @param[out] *elapsed_us pointer to an elapsed time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle or energy is NULL
+ *             - 3 handle is not initialized
+ * @note       the current lsb of the handle is applied here,
+ *             so it must not change during the integration
+ */
+uint8_t ina226_energy_get(ina226_handle_t *handle, const ina226_energy_t *energy, 
+                          double *charge_mC, double *energy_mJ, uint64_t *elapsed_us);
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup ina226_stats_driver ina226 stats driver function
+ * @brief    ina226 stats driver modules
+ * @ingroup  ina226_driver
+ * @{
+ */
+
+/**
+ * @brief     initialize the channel statistics
+ * @param[in] *stats pointer to an ina226 stats structure
+ * @param[in] channel sample channel
+ * @return    status code
+ *            - 0 success
+ *            - 2 stats is NULL
+ * @note      none
+ */
+uint8_t ina226_stats_init(ina226_stats_t *stats, ina226_channel_t channel);
+
+/**
+ * @brief     add a sample to the channel statistics
+ * @param[in] *stats pointer to an ina226 stats structure
+ * @param[in] *sample pointer to a sample structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 stats or sample is NULL
+ * @note      only the raw register of the channel is accumulated
+ */
+uint8_t ina226_stats_update(ina226_stats_t *stats, const ina226_sample_t *sample);
+
+/**
+ * @brief      copy the channel statistics
+ * @param[in]  *stats pointer to an ina226 stats structure
+ * @param[out] *snapshot pointer to an ina226 stats snapshot buffer
+ * @param[in]  reset bool value
+ * @return     status code
+ *             - 0 success
+ *             - 2 stats or snapshot is NULL
+ * @note       reset starts a new window
+ */
+uint8_t ina226_stats_snapshot(ina226_stats_t *stats, ina226_stats_t *snapshot, ina226_bool_t reset);
+
+/**
+ * @brief      get the channel statistics
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[in]  *stats pointer to an ina226 stats structure
+ * @param[out] *min pointer to a min buffer
+ * @param[out] *max pointer to a max buffer
+ * @param[out] *mean pointer to a mean buffer
+ * @param[out] *stddev pointer to a sample standard deviation buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle or stats is NULL
+ *             - 3 handle is not initialized
+ *             - 4 stats is empty
+ * @note       results are in mV, mA or mW of the channel
+ */
+uint8_t ina226_stats_get(ina226_handle_t *handle, const ina226_stats_t *stats, 
+                         float *min, float *max, float *mean, float *stddev);
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup ina226_decimator_driver ina226 decimator driver function
+ * @brief    ina226 decimator driver modules
+ * @ingroup  ina226_driver
+ * @{
+ */
+
+/**
+ * @brief     initialize the decimator
+ * @param[in] *dec pointer to an ina226 decimator structure
+ * @param[in] type decimator type
+ * @param[in] ratio decimation ratio or moving average window
+ * @param[in] order cic order
+ * @param[in] *history pointer to a history buffer of ratio * 4 items
+ * @return    status code
+ *            - 0 success
+ *            - 2 dec is NULL
+ *            - 4 ratio or order is invalid
+ *            - 5 history is NULL
+ * @note      history is only used by the moving average and can be NULL otherwise,
+ *            order is only used by the cic and the filter gain must not exceed 2^32
+ */
+uint8_t ina226_decimator_init(ina226_decimator_t *dec, ina226_decimator_type_t type, 
+                              uint32_t ratio, uint8_t order, uint16_t *history);
+
+/**
+ * @brief     reset the decimator state
+ * @param[in] *dec pointer to an ina226 decimator structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 dec is NULL
+ * @note      none
+ */
+uint8_t ina226_decimator_reset(ina226_decimator_t *dec);
+
+/**
+ * @brief      feed a sample into the decimator
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[in]  *dec pointer to an ina226 decimator structure
+ * @param[in]  *in pointer to an input sample structure
+ * @param[out] *out pointer to an output sample structure
+ * @param[out] *ready pointer to an output ready buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle, dec, in, out or ready is NULL
+ *             - 3 handle is not initialized
+ * @note       out is only written when ready is true,
+ *             the raw fields are rounded and the converted fields keep the extra resolution
+ */
+uint8_t ina226_decimator_update(ina226_handle_t *handle, ina226_decimator_t *dec, 
+                                const ina226_sample_t *in, ina226_sample_t *out, ina226_bool_t *ready);
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup ina226_alert_rule_driver ina226 alert rule driver function
+ * @brief    ina226 alert rule driver modules
+ * @ingroup  ina226_driver
+ * @{
+ */
+
+/**
+ * @brief      compile an alert rule
+ * @param[in]  *handle pointer to an ina226 handle structure
+ * @param[out] *rule pointer to an ina226 alert rule structure
+ * @param[in]  channel watched channel
+ * @param[in]  direction alert direction
+ * @param[in]  set threshold that raises the alert in mV, mA or mW
+ * @param[in]  clear threshold that releases the alert in mV, mA or mW
+ * @param[in]  duration_us minimum time beyond the set threshold
+ * @return     status code
+ *             - 0 success
+ *             - 1 compile failed
+ *             - 2 handle or rule is NULL
+ *             - 3 handle is not initialized
+ *             - 4 clear threshold is on the wrong side of the set threshold
+ * @note       thresholds are converted to raw register units here,
+ *             so the calibration must not change afterwards,
+ *             a threshold out of the register range or a current and power
+ *             threshold without a calibrated current lsb fails to compile
+ */
+uint8_t ina226_alert_rule_init(ina226_handle_t *handle, ina226_alert_rule_t *rule, ina226_channel_t channel, 
+                               ina226_alert_direction_t direction, float set, float clear, uint32_t duration_us);
+
+/**
+ * @brief      check a sample against the alert rules
+ * @param[in]  *rule pointer to an ina226 alert rule array
+ * @param[in]  num rule number
+ * @param[in]  *sample pointer to a timestamped sample structure
+ * @param[out] *active pointer to an active rule mask buffer
+ * @param[out] *changed pointer to a changed rule mask buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 rule, sample, active or changed is NULL
+ *             - 4 num is over 32
+ * @note       only integer compares are done per sample,
+ *             without sample timestamps a rule with a duration never raises
+ */
+uint8_t ina226_alert_rule_check(ina226_alert_rule_t *rule, uint8_t num, const ina226_sample_t *sample, 
+                                uint32_t *active, uint32_t *changed);
+
 /**
  * @}
  */
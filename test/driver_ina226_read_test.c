@@ -61,6 +61,7 @@ uint8_t ina226_read_test(ina226_address_t addr_pin, double r, uint32_t times)
     DRIVER_INA226_LINK_IIC_DEINIT(&gs_handle, ina226_interface_iic_deinit);
     DRIVER_INA226_LINK_IIC_READ(&gs_handle, ina226_interface_iic_read);
     DRIVER_INA226_LINK_IIC_WRITE(&gs_handle, ina226_interface_iic_write);
+    DRIVER_INA226_LINK_IIC_READ_CMD(&gs_handle, ina226_interface_iic_read_cmd);
     DRIVER_INA226_LINK_DELAY_MS(&gs_handle, ina226_interface_delay_ms);
     DRIVER_INA226_LINK_DEBUG_PRINT(&gs_handle, ina226_interface_debug_print);
     DRIVER_INA226_LINK_RECEIVE_CALLBACK(&gs_handle, ina226_interface_receive_callback);
@@ -315,6 +316,52 @@ uint8_t ina226_read_test(ina226_address_t addr_pin, double r, uint32_t times)
         ina226_interface_delay_ms(1000);
     }
     
+    /* set shunt bus voltage continuous */
+    res = ina226_set_mode(&gs_handle, INA226_MODE_SHUNT_BUS_VOLTAGE_CONTINUOUS);
+    if (res != 0)
+    {
+        ina226_interface_debug_print("ina226: set mode failed.\n");
+        (void)ina226_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* read all test */
+    ina226_interface_debug_print("ina226: read all test.\n");
+    
+    /* delay 1000ms */
+    ina226_interface_delay_ms(1000);
+    
+    for (i = 0; i < times; i++)
+    {
+        ina226_sample_t sample;
+        
+        /* read all */
+        res = ina226_read_all(&gs_handle, &sample);
+        if (res != 0)
+        {
+            ina226_interface_debug_print("ina226: read all failed.\n");
+            (void)ina226_deinit(&gs_handle);
+            
+            return 1;
+        }
+        res = ina226_sample_convert_to_data(&gs_handle, &sample);
+        if (res != 0)
+        {
+            ina226_interface_debug_print("ina226: sample convert to data failed.\n");
+            (void)ina226_deinit(&gs_handle);
+            
+            return 1;
+        }
+        ina226_interface_debug_print("ina226: shunt voltage is %0.3fmV.\n", sample.shunt_voltage_mV);
+        ina226_interface_debug_print("ina226: bus voltage is %0.3fmV.\n", sample.bus_voltage_mV);
+        ina226_interface_debug_print("ina226: current is %0.3fmA.\n", sample.current_mA);
+        ina226_interface_debug_print("ina226: power is %0.3fmW.\n", sample.power_mW);
+        
+        /* delay 1000ms */
+        ina226_interface_delay_ms(1000);
+    }
+    
     /* finish read test */
     (void)ina226_deinit(&gs_handle);
     ina226_interface_debug_print("ina226: finish read test.\n");
@@ -36,9 +36,41 @@
 
 #include "driver_ina226_register_test.h"
 #include <stdlib.h>
+#include <string.h>
 
 static ina226_handle_t gs_handle;        /**< ina226 handle */
 
+/**
+ * @brief alert rule test samples definition
+ */
+static const uint64_t gs_rule_time[6] = {0, 100, 200, 300, 400, 1500};                   /**< sample timestamp in us */
+static const uint16_t gs_rule_bus[6] = {3200, 4160, 3920, 3800, 3800, 3800};             /**< bus voltage raw data */
+static const int16_t gs_rule_shunt[6] = {0, 0, 0, 0, -4400, -4400};                      /**< shunt voltage raw data */
+static const uint32_t gs_rule_active[6] = {0x0, 0x1, 0x1, 0x0, 0x0, 0x2};                /**< expected active mask */
+static const uint32_t gs_rule_changed[6] = {0x0, 0x1, 0x0, 0x1, 0x0, 0x2};               /**< expected changed mask */
+
+/**
+ * @brief energy test samples definition
+ */
+static const uint64_t gs_energy_time[4] = {1000, 2000, 4000, 5000};        /**< sample timestamp in us */
+static const int16_t gs_energy_current[4] = {100, 200, 200, -100};         /**< current raw data */
+static const uint16_t gs_energy_power[4] = {10, 20, 20, 10};               /**< power raw data */
+
+/**
+ * @brief stats test samples definition
+ */
+static const uint16_t gs_stats_bus[8] = {3200, 3204, 3196, 3208, 3192, 3200, 3200, 3200};        /**< bus voltage raw data */
+
+/**
+ * @brief decimator test samples definition
+ */
+static const uint16_t gs_decimator_bus[12] = {1000, 1000, 1000, 1000, 2000, 2000, 2000, 2000, 2000, 2000, 2000, 2000};        /**< bus voltage step */
+static const uint16_t gs_decimator_boxcar[3] = {1000, 2000, 2000};                                                             /**< boxcar of 4 outputs */
+static const uint16_t gs_decimator_moving[9] = {1000, 1250, 1500, 1750, 2000, 2000, 2000, 2000, 2000};                         /**< moving average of 4 outputs */
+static const uint16_t gs_decimator_cic[2] = {1625, 2000};                                                                      /**< cic of 4 order 2 outputs, the first one is dropped */
+static const uint16_t *const gs_decimator_out[3] = {gs_decimator_boxcar, gs_decimator_moving, gs_decimator_cic};               /**< expected outputs */
+static const uint8_t gs_decimator_num[3] = {3, 9, 2};                                                                          /**< expected output number */
+
 /**
  * @brief     register test
  * @param[in] addr_pin iic device address
@@ -50,21 +82,40 @@ static ina226_handle_t gs_handle;        /**< ina226 handle */
 uint8_t ina226_register_test(ina226_address_t addr_pin)
 {
     uint8_t res;
+    uint8_t i;
+    uint8_t j;
+    uint8_t k;
     uint8_t die_revision_id;
+    uint32_t active;
+    uint32_t changed;
     float f;
     float f_check;
+    float min;
+    float max;
+    float mean;
+    float stddev;
     double r;
     double r_check;
     uint16_t data;
     uint16_t data_check;
     uint16_t device_id;
+    uint16_t history[16];
     ina226_info_t info;
     ina226_address_t addr;
     ina226_avg_t mode;
     ina226_conversion_time_t t;
     ina226_mode_t chip_mode;
     ina226_bool_t enable;
+    ina226_bool_t ready;
     ina226_alert_polarity_t pin;
+    ina226_config_t config;
+    ina226_config_t config_check;
+    ina226_alert_rule_t rule[2];
+    ina226_sample_t sample;
+    ina226_energy_t energy;
+    ina226_stats_t stats;
+    ina226_decimator_t dec;
+    ina226_sample_t out;
     
     /* link interface function */
     DRIVER_INA226_LINK_INIT(&gs_handle, ina226_handle_t);
@@ -1024,6 +1075,38 @@ uint8_t ina226_register_test(ina226_address_t addr_pin)
     }
     ina226_interface_debug_print("ina226: check mode %s.\n", chip_mode == INA226_MODE_SHUNT_BUS_VOLTAGE_CONTINUOUS ? "ok" : "error");
     
+    /* ina226_set_config/ina226_get_config test */
+    ina226_interface_debug_print("ina226: ina226_set_config/ina226_get_config test.\n");
+    
+    /* set config */
+    config.avg = (ina226_avg_t)(rand() % 8);
+    config.bus_voltage_conversion_time = (ina226_conversion_time_t)(rand() % 8);
+    config.shunt_voltage_conversion_time = (ina226_conversion_time_t)(rand() % 8);
+    config.mode = INA226_MODE_POWER_DOWN;
+    config.calibration = rand() % 0x7FFFU;
+    res = ina226_set_config(&gs_handle, &config, INA226_BOOL_TRUE);
+    if (res != 0)
+    {
+        ina226_interface_debug_print("ina226: set config failed.\n");
+        (void)ina226_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ina226_interface_debug_print("ina226: set config.\n");
+    res = ina226_get_config(&gs_handle, &config_check);
+    if (res != 0)
+    {
+        ina226_interface_debug_print("ina226: get config failed.\n");
+        (void)ina226_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ina226_interface_debug_print("ina226: check config %s.\n", ((config.avg == config_check.avg) &&
+                                 (config.bus_voltage_conversion_time == config_check.bus_voltage_conversion_time) &&
+                                 (config.shunt_voltage_conversion_time == config_check.shunt_voltage_conversion_time) &&
+                                 (config.mode == config_check.mode) &&
+                                 (config.calibration == config_check.calibration)) ? "ok" : "error");
+    
     /* ina226_set_calibration/ina226_get_calibration test */
     ina226_interface_debug_print("ina226: ina226_set_calibration/ina226_get_calibration test.\n");
     
@@ -1061,6 +1144,22 @@ uint8_t ina226_register_test(ina226_address_t addr_pin)
     }
     ina226_interface_debug_print("ina226: calculate calibration is 0x%04X.\n", data_check);
     
+    /* ina226_calculate_calibration_ex test */
+    ina226_interface_debug_print("ina226: ina226_calculate_calibration_ex test.\n");
+    
+    /* calculate calibration ex */
+    res = ina226_calculate_calibration_ex(&gs_handle, 100.0f, INA226_BOOL_TRUE, &data_check, &f, &f_check);
+    if (res != 0)
+    {
+        ina226_interface_debug_print("ina226: calculate calibration ex failed.\n");
+        (void)ina226_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ina226_interface_debug_print("ina226: calculate calibration ex is 0x%04X.\n", data_check);
+    ina226_interface_debug_print("ina226: current lsb is %0.6fmA.\n", f);
+    ina226_interface_debug_print("ina226: check headroom %s.\n", f_check >= 0.0f ? "ok" : "error");
+    
     /* ina226_set_mask/ina226_get_mask test */
     ina226_interface_debug_print("ina226: ina226_set_mask/ina226_get_mask test.\n");
     
@@ -1416,6 +1515,71 @@ uint8_t ina226_register_test(ina226_address_t addr_pin)
     }
     ina226_interface_debug_print("ina226: check alert limit %s.\n", data == data_check ? "ok" : "error");
     
+    /* ina226_set_register_cache/ina226_get_register_cache test */
+    ina226_interface_debug_print("ina226: ina226_set_register_cache/ina226_get_register_cache test.\n");
+    
+    /* enable register cache */
+    res = ina226_set_register_cache(&gs_handle, INA226_BOOL_TRUE);
+    if (res != 0)
+    {
+        ina226_interface_debug_print("ina226: set register cache failed.\n");
+        (void)ina226_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ina226_interface_debug_print("ina226: enable register cache.\n");
+    res = ina226_get_register_cache(&gs_handle, &enable);
+    if (res != 0)
+    {
+        ina226_interface_debug_print("ina226: get register cache failed.\n");
+        (void)ina226_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ina226_interface_debug_print("ina226: check register cache %s.\n", enable == INA226_BOOL_TRUE ? "ok" : "error");
+    
+    /* cached alert limit must match the chip */
+    res = ina226_get_alert_limit(&gs_handle, &data_check);
+    if (res != 0)
+    {
+        ina226_interface_debug_print("ina226: get alert limit failed.\n");
+        (void)ina226_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ina226_interface_debug_print("ina226: check cached alert limit %s.\n", data == data_check ? "ok" : "error");
+    
+    /* resync register cache */
+    res = ina226_resync_register_cache(&gs_handle);
+    if (res != 0)
+    {
+        ina226_interface_debug_print("ina226: resync register cache failed.\n");
+        (void)ina226_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ina226_interface_debug_print("ina226: resync register cache.\n");
+    
+    /* disable register cache */
+    res = ina226_set_register_cache(&gs_handle, INA226_BOOL_FALSE);
+    if (res != 0)
+    {
+        ina226_interface_debug_print("ina226: set register cache failed.\n");
+        (void)ina226_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ina226_interface_debug_print("ina226: disable register cache.\n");
+    res = ina226_get_register_cache(&gs_handle, &enable);
+    if (res != 0)
+    {
+        ina226_interface_debug_print("ina226: get register cache failed.\n");
+        (void)ina226_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ina226_interface_debug_print("ina226: check register cache %s.\n", enable == INA226_BOOL_FALSE ? "ok" : "error");
+    
     /* ina226_shunt_voltage_convert_to_register/ina226_shunt_voltage_convert_to_data test */
     ina226_interface_debug_print("ina226: ina226_shunt_voltage_convert_to_register/ina226_shunt_voltage_convert_to_data test.\n");
     
@@ -1485,6 +1649,253 @@ uint8_t ina226_register_test(ina226_address_t addr_pin)
     }
     ina226_interface_debug_print("ina226: check power %0.2fmW.\n", f_check);
     
+    /* ina226_current_convert_to_register/ina226_current_convert_to_data test */
+    ina226_interface_debug_print("ina226: ina226_current_convert_to_register/ina226_current_convert_to_data test.\n");
+    
+    f = -(float)(rand() % 1000) / 100.0f;
+    res = ina226_current_convert_to_register(&gs_handle, f, &data);
+    if (res != 0)
+    {
+        ina226_interface_debug_print("ina226: current convert to register failed.\n");
+        (void)ina226_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ina226_interface_debug_print("ina226: set current %0.2fmA.\n", f);
+    res = ina226_current_convert_to_data(&gs_handle, data, &f_check);
+    if (res != 0)
+    {
+        ina226_interface_debug_print("ina226: current convert to data failed.\n");
+        (void)ina226_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ina226_interface_debug_print("ina226: check current %0.2fmA.\n", f_check);
+    
+    /* ina226_alert_rule_init/ina226_alert_rule_check test */
+    ina226_interface_debug_print("ina226: ina226_alert_rule_init/ina226_alert_rule_check test.\n");
+    
+    /* out of range threshold */
+    res = ina226_alert_rule_init(&gs_handle, &rule[0], INA226_CHANNEL_BUS_VOLTAGE, INA226_ALERT_DIRECTION_OVER, 
+                                 50000.0f, 4800.0f, 0);
+    if (res != 1)
+    {
+        ina226_interface_debug_print("ina226: alert rule init range check failed.\n");
+        (void)ina226_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ina226_interface_debug_print("ina226: check out of range threshold %s.\n", "ok");
+    
+    /* bus voltage over 5000mV, released at 4800mV */
+    res = ina226_alert_rule_init(&gs_handle, &rule[0], INA226_CHANNEL_BUS_VOLTAGE, INA226_ALERT_DIRECTION_OVER, 
+                                 5000.0f, 4800.0f, 0);
+    if (res != 0)
+    {
+        ina226_interface_debug_print("ina226: alert rule init failed.\n");
+        (void)ina226_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* shunt voltage under -10mV for 1000us, released at -9mV */
+    res = ina226_alert_rule_init(&gs_handle, &rule[1], INA226_CHANNEL_SHUNT_VOLTAGE, INA226_ALERT_DIRECTION_UNDER, 
+                                 -10.0f, -9.0f, 1000);
+    if (res != 0)
+    {
+        ina226_interface_debug_print("ina226: alert rule init failed.\n");
+        (void)ina226_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* feed the synthetic samples */
+    memset(&sample, 0, sizeof(ina226_sample_t));
+    for (i = 0; i < 6; i++)
+    {
+        sample.timestamp_us = gs_rule_time[i];
+        sample.bus_voltage_raw = gs_rule_bus[i];
+        sample.shunt_voltage_raw = gs_rule_shunt[i];
+        res = ina226_alert_rule_check(rule, 2, &sample, &active, &changed);
+        if (res != 0)
+        {
+            ina226_interface_debug_print("ina226: alert rule check failed.\n");
+            (void)ina226_deinit(&gs_handle);
+            
+            return 1;
+        }
+        if ((active != gs_rule_active[i]) || (changed != gs_rule_changed[i]))
+        {
+            ina226_interface_debug_print("ina226: sample %d active 0x%02X changed 0x%02X is wrong.\n", i, 
+                                         (unsigned int)active, (unsigned int)changed);
+            (void)ina226_deinit(&gs_handle);
+            
+            return 1;
+        }
+    }
+    ina226_interface_debug_print("ina226: check alert rule %s.\n", "ok");
+    
+    /* ina226_energy_reset/ina226_energy_update test */
+    ina226_interface_debug_print("ina226: ina226_energy_reset/ina226_energy_update test.\n");
+    
+    /* reset the energy */
+    res = ina226_energy_reset(&energy);
+    if (res != 0)
+    {
+        ina226_interface_debug_print("ina226: energy reset failed.\n");
+        (void)ina226_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* feed the synthetic samples */
+    memset(&sample, 0, sizeof(ina226_sample_t));
+    for (i = 0; i < 4; i++)
+    {
+        sample.timestamp_us = gs_energy_time[i];
+        sample.current_raw = gs_energy_current[i];
+        sample.power_raw = gs_energy_power[i];
+        res = ina226_energy_update(&energy, &sample);
+        if (res != 0)
+        {
+            ina226_interface_debug_print("ina226: energy update failed.\n");
+            (void)ina226_deinit(&gs_handle);
+            
+            return 1;
+        }
+    }
+    
+    /* trapezoid sums of (x[n - 1] + x[n]) * dt */
+    if ((energy.charge_raw != 1200000) || (energy.energy_raw != 140000) || (energy.elapsed_us != 4000))
+    {
+        ina226_interface_debug_print("ina226: energy charge %d energy %d elapsed %d is wrong.\n", 
+                                     (int)energy.charge_raw, (int)energy.energy_raw, (int)energy.elapsed_us);
+        (void)ina226_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* a repeated timestamp is rejected */
+    res = ina226_energy_update(&energy, &sample);
+    if (res != 4)
+    {
+        ina226_interface_debug_print("ina226: energy timestamp check failed.\n");
+        (void)ina226_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ina226_interface_debug_print("ina226: check energy %s.\n", "ok");
+    
+    /* ina226_stats_init/ina226_stats_update/ina226_stats_get test */
+    ina226_interface_debug_print("ina226: ina226_stats_init/ina226_stats_update/ina226_stats_get test.\n");
+    
+    /* init the bus voltage stats */
+    res = ina226_stats_init(&stats, INA226_CHANNEL_BUS_VOLTAGE);
+    if (res != 0)
+    {
+        ina226_interface_debug_print("ina226: stats init failed.\n");
+        (void)ina226_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* an empty stats is rejected */
+    res = ina226_stats_get(&gs_handle, &stats, &min, &max, &mean, &stddev);
+    if (res != 4)
+    {
+        ina226_interface_debug_print("ina226: stats empty check failed.\n");
+        (void)ina226_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* feed the synthetic samples */
+    memset(&sample, 0, sizeof(ina226_sample_t));
+    for (i = 0; i < 8; i++)
+    {
+        sample.bus_voltage_raw = gs_stats_bus[i];
+        res = ina226_stats_update(&stats, &sample);
+        if (res != 0)
+        {
+            ina226_interface_debug_print("ina226: stats update failed.\n");
+            (void)ina226_deinit(&gs_handle);
+            
+            return 1;
+        }
+    }
+    res = ina226_stats_get(&gs_handle, &stats, &min, &max, &mean, &stddev);
+    if (res != 0)
+    {
+        ina226_interface_debug_print("ina226: stats get failed.\n");
+        (void)ina226_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* 1.25mV lsb, the sample variance is 160 / 7 */
+    if ((stats.count != 8) || (min != 3990.0f) || (max != 4010.0f) || (mean != 4000.0f) || 
+        ((stddev - 5.9761f) > 0.001f) || ((stddev - 5.9761f) < -0.001f))
+    {
+        ina226_interface_debug_print("ina226: stats min %0.3fmV max %0.3fmV mean %0.3fmV stddev %0.4fmV is wrong.\n", 
+                                     min, max, mean, stddev);
+        (void)ina226_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ina226_interface_debug_print("ina226: check stats %s.\n", "ok");
+    
+    /* ina226_decimator_init/ina226_decimator_update test */
+    ina226_interface_debug_print("ina226: ina226_decimator_init/ina226_decimator_update test.\n");
+    
+    /* boxcar, moving average and cic */
+    for (k = 0; k < 3; k++)
+    {
+        /* ratio 4 and cic order 2 */
+        res = ina226_decimator_init(&dec, (ina226_decimator_type_t)k, 4, 2, history);
+        if (res != 0)
+        {
+            ina226_interface_debug_print("ina226: decimator init failed.\n");
+            (void)ina226_deinit(&gs_handle);
+            
+            return 1;
+        }
+        
+        /* feed the step */
+        memset(&sample, 0, sizeof(ina226_sample_t));
+        for (i = 0, j = 0; i < 12; i++)
+        {
+            sample.bus_voltage_raw = gs_decimator_bus[i];
+            res = ina226_decimator_update(&gs_handle, &dec, &sample, &out, &ready);
+            if (res != 0)
+            {
+                ina226_interface_debug_print("ina226: decimator update failed.\n");
+                (void)ina226_deinit(&gs_handle);
+                
+                return 1;
+            }
+            if (ready != INA226_BOOL_TRUE)
+            {
+                continue;
+            }
+            if ((j >= gs_decimator_num[k]) || (out.bus_voltage_raw != gs_decimator_out[k][j]))
+            {
+                ina226_interface_debug_print("ina226: decimator %d output %d is wrong.\n", k, j);
+                (void)ina226_deinit(&gs_handle);
+                
+                return 1;
+            }
+            j++;
+        }
+        if (j != gs_decimator_num[k])
+        {
+            ina226_interface_debug_print("ina226: decimator %d output number %d is wrong.\n", k, j);
+            (void)ina226_deinit(&gs_handle);
+            
+            return 1;
+        }
+    }
+    ina226_interface_debug_print("ina226: check decimator %s.\n", "ok");
+    
     /* ina226_get_die_id test */
     ina226_interface_debug_print("ina226: ina226_get_die_id test.\n");
     